@@ -0,0 +1,77 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <rsl/log>
+
+namespace rsl::logging::bench {
+// number of heap allocations made by any thread since startup
+std::uint64_t allocations();
+
+class State {
+  std::uint64_t iterations_           = 0;
+  double ns_per_op_                   = 0;
+  double allocations_per_op_          = 0;
+  std::vector<std::pair<std::string, double>> counters_;
+
+public:
+  constexpr static auto min_time = std::chrono::milliseconds(200);
+
+  // Calls `body` repeatedly, doubling the iteration count until the measurement takes at least
+  // `min_time`. Returns the number of iterations of the final measurement.
+  template <typename F>
+  std::uint64_t run(F&& body) {
+    body();  // warm up lazily initialized state
+
+    for (std::uint64_t iterations = 1;; iterations *= 2) {
+      auto const allocations_before = allocations();
+      auto const start              = std::chrono::steady_clock::now();
+      for (std::uint64_t idx = 0; idx < iterations; ++idx) {
+        body();
+      }
+      auto const elapsed            = std::chrono::steady_clock::now() - start;
+      auto const allocations_after  = allocations();
+
+      if (elapsed >= min_time || iterations >= (1ULL << 32U)) {
+        iterations_ = iterations;
+        ns_per_op_  = double(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+                     double(iterations);
+        allocations_per_op_ = double(allocations_after - allocations_before) / double(iterations);
+        return iterations;
+      }
+    }
+  }
+
+  void counter(std::string name, double value) { counters_.emplace_back(std::move(name), value); }
+
+  [[nodiscard]] std::uint64_t iterations() const { return iterations_; }
+  [[nodiscard]] double ns_per_op() const { return ns_per_op_; }
+  [[nodiscard]] double allocations_per_op() const { return allocations_per_op_; }
+  [[nodiscard]] auto const& counters() const { return counters_; }
+};
+
+using Function = void (*)(State&);
+
+struct Benchmark {
+  std::string_view name;
+  Function function;
+};
+
+std::vector<Benchmark>& registry();
+
+inline bool add(std::string_view name, Function function) {
+  registry().push_back({name, function});
+  return true;
+}
+
+struct DiscardSink : Sink {
+  void emit_event(Event const&) {}
+};
+
+// Benchmarks installing their own output must restore this one before their output is destroyed.
+Output<DiscardSink>& discard_output();
+}  // namespace rsl::logging::bench
@@ -0,0 +1,28 @@
+#include <chrono>
+
+#include <rsl/logging/clock.hpp>
+
+#include "bench.hpp"
+
+namespace rsl::logging::bench {
+namespace {
+template <typename T>
+void keep(T const& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+auto const system_clock_now = add("clock/system_clock_now", [](State& state) {
+  state.run([] { keep(std::chrono::system_clock::now()); });
+});
+
+auto const timestamp_now = add("clock/timestamp_now", [](State& state) {
+  state.run([] { keep(Timestamp::now()); });
+});
+
+// what sinks pay when rendering an event
+auto const timestamp_to_sys = add("clock/timestamp_to_sys", [](State& state) {
+  auto timestamp = Timestamp::now();
+  state.run([&] { keep(timestamp.to_sys()); });
+});
+}  // namespace
+}  // namespace rsl::logging::bench
@@ -0,0 +1,68 @@
+#include <coroutine>
+#include <deque>
+#include <exception>
+
+#include "bench.hpp"
+
+namespace rsl::logging::bench {
+namespace {
+struct Task {
+  struct promise_type {
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+rsl::co_trace<Task> suspend_forever() {
+  auto _ = ContextGuard("coroutine", LogLevel::INHERIT);
+  while (true) {
+    co_await std::suspend_always{};
+  }
+}
+
+// events filtered by an inherited context level, the root of the chain sits `depth` levels up
+void run_filtered(State& state, std::size_t depth) {
+  Context root{"root", LogLevel::ERROR};
+  root.enter();
+  std::deque<Context> nested;
+  for (std::size_t idx = 1; idx < depth; ++idx) {
+    nested.emplace_back("nested", LogLevel::INHERIT).enter();
+  }
+
+  state.run([] { rsl::info("filtered by context"); });
+
+  while (not nested.empty()) {
+    nested.back().exit();
+    nested.pop_back();
+  }
+  root.exit();
+}
+
+auto const depth_1 = add("context/filtered_depth_1", [](State& state) { run_filtered(state, 1); });
+auto const depth_16 = add("context/filtered_depth_16", [](State& state) { run_filtered(state, 16); });
+auto const depth_256 = add("context/filtered_depth_256", [](State& state) {
+  run_filtered(state, 256);
+});
+
+auto const next_id = add("context/next_id", [](State& state) {
+  state.run([] { return Context::next_id(); });
+});
+
+// the per-coroutine-suspension pattern, constructing and entering a short-lived context
+auto const create = add("context/create_enter_exit", [](State& state) {
+  state.run([] {
+    Context context{"short", LogLevel::INHERIT};
+    context.enter();
+    context.exit();
+  });
+});
+
+// one resume and the following suspension, each hands the coroutine's context over
+auto const co_trace_cycle = add("context/co_trace_resume_suspend", [](State& state) {
+  auto task = suspend_forever();
+  state.run([&] { task.handle().resume(); });
+});
+}  // namespace
+}  // namespace rsl::logging::bench
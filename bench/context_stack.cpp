@@ -0,0 +1,53 @@
+#include <deque>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace rsl::logging::bench {
+namespace {
+constexpr std::size_t span_count = 10'000;
+
+// Enters all spans, then exits every other one before unwinding the rest - most exits
+// happen far from the top of the stack, like interleaved requests on a server thread.
+void interleave(std::deque<Context>& spans) {
+  for (auto& span : spans) {
+    span.enter();
+  }
+  for (std::size_t idx = 0; idx < spans.size(); idx += 2) {
+    spans[idx].exit();
+  }
+  for (std::size_t idx = spans.size() - spans.size() % 2; idx > 0; idx -= 2) {
+    spans[idx - 1].exit();
+  }
+}
+
+std::deque<Context> make_spans() {
+  std::deque<Context> spans;
+  for (std::size_t idx = 0; idx < span_count; ++idx) {
+    spans.emplace_back("span", LogLevel::INHERIT);
+  }
+  return spans;
+}
+
+auto const interleaved = add("context/interleaved_10k", [](State& state) {
+  auto spans = make_spans();
+  state.run([&] { interleave(spans); });
+  state.counter("ns_per_span", state.ns_per_op() / double(span_count));
+});
+
+auto const interleaved_threads = add("context/interleaved_10k_4_threads", [](State& state) {
+  std::deque<std::deque<Context>> spans;
+  for (int idx = 0; idx < 4; ++idx) {
+    spans.push_back(make_spans());
+  }
+  state.run([&] {
+    std::vector<std::jthread> threads;
+    for (auto& thread_spans : spans) {
+      threads.emplace_back([&thread_spans] { interleave(thread_spans); });
+    }
+  });
+  state.counter("ns_per_span", state.ns_per_op() / double(span_count));
+});
+}  // namespace
+}  // namespace rsl::logging::bench
@@ -0,0 +1,108 @@
+#include "bench.hpp"
+
+namespace rsl::logging::bench {
+namespace {
+// RSL_LOG_ARGS captures every parameter of the enclosing function
+void capture_0() {
+  rsl::info(RSL_LOG_ARGS, "captured");
+}
+
+void capture_4(int a0, int a1, int a2, int a3) {
+  rsl::info(RSL_LOG_ARGS, "captured");
+}
+
+void capture_32(int a0,
+                int a1,
+                int a2,
+                int a3,
+                int a4,
+                int a5,
+                int a6,
+                int a7,
+                int a8,
+                int a9,
+                int a10,
+                int a11,
+                int a12,
+                int a13,
+                int a14,
+                int a15,
+                int a16,
+                int a17,
+                int a18,
+                int a19,
+                int a20,
+                int a21,
+                int a22,
+                int a23,
+                int a24,
+                int a25,
+                int a26,
+                int a27,
+                int a28,
+                int a29,
+                int a30,
+                int a31) {
+  rsl::info(RSL_LOG_ARGS, "captured");
+}
+
+void kwargs_context(int request, int attempt) {
+  RSL_LOG_CONTEXT("kwargs", rsl::log_level::INHERIT, id = request, retry = attempt);
+}
+
+auto const args_0 = add("args/capture_0", [](State& state) {
+  state.run([] { capture_0(); });
+});
+
+auto const args_4 = add("args/capture_4", [](State& state) {
+  state.run([] { capture_4(0, 1, 2, 3); });
+});
+
+auto const args_32 = add("args/capture_32", [](State& state) {
+  state.run([] {
+    capture_32(0,
+               1,
+               2,
+               3,
+               4,
+               5,
+               6,
+               7,
+               8,
+               9,
+               10,
+               11,
+               12,
+               13,
+               14,
+               15,
+               16,
+               17,
+               18,
+               19,
+               20,
+               21,
+               22,
+               23,
+               24,
+               25,
+               26,
+               27,
+               28,
+               29,
+               30,
+               31);
+  });
+});
+
+// function arguments and two keyword fields, entered and exited
+auto const kwargs = add("context/kwargs_guard", [](State& state) {
+  int attempt = 0;
+  state.run([&] { kwargs_context(42, attempt++); });
+});
+
+auto const guard = add("context/guard", [](State& state) {
+  state.run([] { auto _ = ContextGuard("guard", LogLevel::INHERIT); });
+});
+}  // namespace
+}  // namespace rsl::logging::bench
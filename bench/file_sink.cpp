@@ -0,0 +1,51 @@
+#include <filesystem>
+
+#include <rsl/logging/sinks.hpp>
+
+#include "bench.hpp"
+
+namespace rsl::logging::bench {
+namespace {
+constexpr std::size_t batch_size = 10'000;
+
+void run_file_sink(State& state, FileSink::Options options) {
+  auto path = std::filesystem::temp_directory_path() / "rsl-log-bench-file.log";
+  std::filesystem::remove(path);
+  options.path = path;
+
+  auto sink   = FileSink(options);
+  auto output = Output(sink);
+  set_output(output);
+
+  // the sink counts over every batch, including the warm-up and the shorter rounds
+  std::uint64_t batches = 0;
+  state.run([&] {
+    for (std::size_t idx = 0; idx < batch_size; ++idx) {
+      rsl::info("file sink benchmark event {}", idx);
+    }
+    sink.flush();
+    ++batches;
+  });
+
+  auto stats = sink.stats();
+  state.counter("writes_per_10k_events", double(stats.writes) / double(batches));
+  state.counter("syncs_per_10k_events", double(stats.syncs) / double(batches));
+  state.counter("ns_per_event", state.ns_per_op() / double(batch_size));
+
+  set_output(discard_output());
+  std::filesystem::remove(path);
+}
+
+auto const buffered = add("file_sink/buffered", [](State& state) {
+  run_file_sink(state, {});
+});
+
+auto const periodic_sync = add("file_sink/periodic_sync", [](State& state) {
+  run_file_sink(state, {.durability = FileSink::Durability::PERIODIC});
+});
+
+auto const small_buffer = add("file_sink/small_buffer", [](State& state) {
+  run_file_sink(state, {.buffer_size = 4096});
+});
+}  // namespace
+}  // namespace rsl::logging::bench
@@ -0,0 +1,86 @@
+#include <array>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <rsl/logging/sinks.hpp>
+
+#include "bench.hpp"
+
+namespace rsl::logging::bench {
+namespace {
+constexpr std::size_t batch_size = 10'000;
+
+struct Request {
+  std::string method;
+  std::string path;
+  int status;
+  std::vector<int> retries;
+};
+
+// TerminalSink always prints to stdout, point it at /dev/null while measuring
+struct DiscardStdout {
+  int saved;
+
+  DiscardStdout() : saved(::dup(STDOUT_FILENO)) {
+    std::fflush(stdout);
+    int null = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+    ::dup2(null, STDOUT_FILENO);
+    ::close(null);
+  }
+
+  ~DiscardStdout() {
+    std::fflush(stdout);
+    ::dup2(saved, STDOUT_FILENO);
+    ::close(saved);
+  }
+};
+
+template <typename T>
+void run_sink(State& state, T sink) {
+  auto output = Output(sink);
+  set_output(output);
+
+  auto request = Request{.method = "GET", .path = "/index.html", .status = 200, .retries = {1, 2}};
+  auto guard   = ContextGuard<>("bench", LogLevel::INFO);
+  state.run([&] {
+    for (std::size_t idx = 0; idx < batch_size; ++idx) {
+      rsl::info("sink benchmark event {} for {}", idx, request.path);
+    }
+  });
+  state.counter("ns_per_event", state.ns_per_op() / double(batch_size));
+
+  set_output(discard_output());
+}
+
+auto const terminal = add("sink/terminal", [](State& state) {
+  auto _ = DiscardStdout();
+  run_sink(state, TerminalSink());
+  TerminalSink::flush();
+});
+
+auto const json_lines = add("sink/json_lines", [](State& state) {
+  std::FILE* null = std::fopen("/dev/null", "wb");
+  std::setvbuf(null, nullptr, _IOFBF, 1U << 16U);
+  run_sink(state, JsonLinesSink(null));
+  std::fclose(null);
+});
+
+auto const field_to_json = add("field/to_json", [](State& state) {
+  auto request = Request{.method = "GET", .path = "/index.html", .status = 200, .retries = {1, 2}};
+  auto labels  = std::map<std::string, std::string>{{"region", "eu"}, {"tier", "gold"}};
+  auto fields  = std::array{Field("request", &request), Field("labels", &labels)};
+  std::string out;
+  state.run([&] {
+    out.clear();
+    for (auto const& field : fields) {
+      field.to_json(out);
+    }
+  });
+});
+}  // namespace
+}  // namespace rsl::logging::bench
@@ -0,0 +1,89 @@
+#include <cstddef>
+#include <utility>
+
+#include "bench.hpp"
+
+namespace rsl::logging {
+namespace bench {
+// selects NullLogger for calls to `emit_event<Level, NullTag>`, everything else keeps using the
+// default logger
+struct NullTag {};
+}  // namespace bench
+
+template <>
+constexpr inline auto selected_logger<bench::NullTag> = NullLogger();
+
+namespace bench {
+namespace {
+// INFO is below the annotated minimum, the callsite is never registered
+[[= rsl::min_log_level::ERROR]] void disabled_at_compile_time(std::size_t idx) {
+  rsl::info("disabled at compile time {}", idx);
+}
+
+// renders every event, unlike DiscardSink
+struct RenderSink : Sink {
+  std::size_t bytes = 0;
+  void emit_event(Event const& event) { bytes += event.text().size(); }
+};
+
+// cheap, but not free - stands in for a typical level or field check
+struct Pass : Filter {
+  LogLevel level = LogLevel::TRACE;
+  bool check(Metadata const& meta) const { return meta.severity >= level; }
+};
+
+template <std::size_t Depth>
+void run_filter_chain(State& state) {
+  auto output = [&]<std::size_t... Idx>(std::index_sequence<Idx...>) {
+    return Output(All((void(Idx), Pass())..., DiscardSink()));
+  }(std::make_index_sequence<Depth>());
+  set_output(output);
+
+  std::size_t idx = 0;
+  state.run([&] { rsl::info("filtered event {}", idx++); });
+
+  set_output(discard_output());
+}
+
+auto const compile_time = add("level/compile_time_disabled", [](State& state) {
+  std::size_t idx = 0;
+  state.run([&] { disabled_at_compile_time(idx++); });
+});
+
+// the context level check, see context/filtered_depth_* for deeper chains
+auto const runtime = add("level/runtime_disabled_by_context", [](State& state) {
+  Context context{"quiet", LogLevel::ERROR};
+  context.enter();
+  std::size_t idx = 0;
+  state.run([&] { rsl::info("disabled by context {}", idx++); });
+  context.exit();
+});
+
+auto const null_logger = add("logger/null", [](State& state) {
+  std::size_t idx = 0;
+  state.run([&] {
+    emit_event<LogLevel::INFO, NullTag>(nullptr, current_context, "null logger {}", idx++);
+  });
+});
+
+// collects metadata and dispatches through the output, the text is never rendered
+auto const default_discard = add("logger/default_discard", [](State& state) {
+  std::size_t idx = 0;
+  state.run([&] { rsl::info("discarded {}", idx++); });
+});
+
+auto const default_render = add("logger/default_render", [](State& state) {
+  auto output = Output(RenderSink());
+  set_output(output);
+  std::size_t idx = 0;
+  state.run([&] { rsl::info("rendered {}", idx++); });
+  set_output(discard_output());
+});
+
+auto const chain_1 = add("filter/chain_1", run_filter_chain<1>);
+auto const chain_2 = add("filter/chain_2", run_filter_chain<2>);
+auto const chain_4 = add("filter/chain_4", run_filter_chain<4>);
+auto const chain_8 = add("filter/chain_8", run_filter_chain<8>);
+}  // namespace
+}  // namespace bench
+}  // namespace rsl::logging
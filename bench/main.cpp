@@ -0,0 +1,59 @@
+#include <cstdio>
+#include <print>
+#include <string_view>
+
+#include <counter.hpp>
+
+#include "bench.hpp"
+
+namespace rsl::logging::bench {
+std::uint64_t allocations() {
+  return testing::total_allocations().count;
+}
+
+std::vector<Benchmark>& registry() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+Output<DiscardSink>& discard_output() {
+  static auto output = Output(DiscardSink());
+  return output;
+}
+}  // namespace rsl::logging::bench
+
+// Runs every registered benchmark (or those containing the filter argument) and prints the
+// results as a JSON document to stdout.
+int main(int argc, char** argv) {
+  using namespace rsl::logging;
+  auto filter = argc > 1 ? std::string_view(argv[1]) : std::string_view();
+  set_output(bench::discard_output());
+
+  std::FILE* out = stdout;
+  std::print(out, "{{\"benchmarks\":[");
+  bool first = true;
+  for (auto const& benchmark : bench::registry()) {
+    if (not filter.empty() && not benchmark.name.contains(filter)) {
+      continue;
+    }
+
+    auto state = bench::State();
+    benchmark.function(state);
+    set_output(bench::discard_output());
+
+    std::print(out,
+               "{}\n  {{\"name\":\"{}\",\"iterations\":{},\"ns_per_op\":{:.2f},\"allocations_per_op\":{:.3f}",
+               first ? "" : ",",
+               benchmark.name,
+               state.iterations(),
+               state.ns_per_op(),
+               state.allocations_per_op());
+    for (auto const& [name, value] : state.counters()) {
+      std::print(out, ",\"{}\":{:.3f}", name, value);
+    }
+    std::print(out, "}}");
+    std::fflush(out);
+    first = false;
+  }
+  std::println(out, "\n]}}");
+}
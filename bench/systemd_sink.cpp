@@ -0,0 +1,32 @@
+#include <array>
+
+#include <rsl/logging/sinks.hpp>
+
+#include "bench.hpp"
+
+// Without a running journald sd_journal_sendv fails right away, which still measures
+// everything the sink does before handing the entry to the socket.
+
+namespace rsl::logging::bench {
+namespace {
+constexpr std::size_t batch_size = 1'000;
+
+auto const systemd = add("sink/systemd", [](State& state) {
+  auto sink   = SystemdSink();
+  auto output = Output(sink);
+  set_output(output);
+
+  int shard  = 3;
+  auto guard = ContextGuard<>("bench", LogLevel::INFO, std::array{Field("shard", &shard)});
+  state.run([&] {
+    for (std::size_t idx = 0; idx < batch_size; ++idx) {
+      rsl::info("systemd sink benchmark event {}", idx);
+    }
+  });
+  state.counter("ns_per_event", state.ns_per_op() / double(batch_size));
+  state.counter("allocations_per_event", state.allocations_per_op() / double(batch_size));
+
+  set_output(discard_output());
+});
+}  // namespace
+}  // namespace rsl::logging::bench
@@ -21,11 +21,14 @@ class rsltestRecipe(ConanFile):
         "tests": [True, False],
         "coverage": [True, False],
         "examples": [True, False],
+        "benchmarks": [True, False],
+        "tsc_clock": [True, False],
+        "metrics": [True, False],
         "editable": [True, False]
     }
 
-    default_options = {"shared": False, "fPIC": True, "tests": False, "coverage": False, "examples": False, "editable": False}
-    exports_sources = "CMakeLists.txt", "src/*", "include/*", "example/*", "test/*"
+    default_options = {"shared": False, "fPIC": True, "tests": False, "coverage": False, "examples": False, "benchmarks": False, "tsc_clock": False, "metrics": True, "editable": False}
+    exports_sources = "CMakeLists.txt", "src/*", "include/*", "example/*", "test/*", "tools/*", "bench/*"
 
     def config_options(self):
         if self.settings.os == "Windows":
@@ -53,7 +56,10 @@ class rsltestRecipe(ConanFile):
         cmake.configure(variables={
                     "ENABLE_COVERAGE": self.options.coverage,
                     "BUILD_EXAMPLES": self.options.examples,
-                    "BUILD_TESTING": self.options.tests
+                    "BUILD_TESTING": self.options.tests,
+                    "BUILD_BENCHMARKS": self.options.benchmarks,
+                    "TSC_CLOCK": self.options.tsc_clock,
+                    "METRICS": self.options.metrics
                 })
         cmake.build()
         if self.options.editable:
@@ -70,4 +76,10 @@ class rsltestRecipe(ConanFile):
         self.cpp_info.components["log"].includedirs = ["include"]
         self.cpp_info.components["log"].libdirs = ["lib"]
         self.cpp_info.components["log"].requires = []
-        self.cpp_info.components["log"].libs = ["rsl-log"]
\ No newline at end of file
+        self.cpp_info.components["log"].libs = ["rsl-log"]
+        defines = []
+        if self.options.tsc_clock:
+            defines.append("RSL_LOG_TSC_CLOCK=1")
+        if not self.options.metrics:
+            defines.append("RSL_LOG_METRICS=0")
+        self.cpp_info.components["log"].defines = defines
\ No newline at end of file
@@ -0,0 +1,25 @@
+#include <rsl/log>
+#include <rsl/logging/flavor/async.hpp>
+#include <thread>
+#include <vector>
+
+template <>
+constexpr inline auto rsl::logging::selected_logger<> = rsl::logging::AsyncLogger();
+
+void worker(int idx) {
+  auto _ = rsl::logging::ContextGuard("worker", rsl::logging::LogLevel::INFO);
+  for (int i = 0; i < 3; ++i) {
+    rsl::info("worker {} iteration {}", idx, i);
+  }
+}
+
+int main() {
+  std::vector<std::thread> threads;
+  for (int idx = 0; idx < 4; ++idx) {
+    threads.emplace_back(worker, idx);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  rsl::logging::AsyncLogger::flush();
+}
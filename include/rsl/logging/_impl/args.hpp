@@ -1,9 +1,10 @@
 #pragma once
 #include <meta>
 #include <ranges>
+#include <string>
+#include <string_view>
 
 #include <rsl/logging/field.hpp>
-#include <rsl/util/to_string.hpp>
 
 namespace rsl::logging {
 namespace _impl {
@@ -11,6 +12,26 @@ namespace _impl {
 constexpr inline struct Tombstone {
   constexpr auto operator&() const noexcept { return *this; }
 } tombstone;
+
+// names need static storage - fields only hold a view
+consteval std::string_view parameter_name(std::meta::info scope, std::size_t idx) {
+  auto params = parameters_of(scope);
+  if (has_identifier(params[idx])) {
+    return std::define_static_string(identifier_of(params[idx]));
+  }
+
+  std::size_t unnamed = 0;
+  for (std::size_t current = 0; current < idx; ++current) {
+    unnamed += has_identifier(params[current]) ? 0 : 1;
+  }
+
+  std::string digits;
+  do {
+    digits.insert(digits.begin(), static_cast<char>('0' + (unnamed % 10)));
+    unnamed /= 10;
+  } while (unnamed != 0);
+  return std::define_static_string("unnamed_" + digits);
+}
 }  // namespace _impl
 
 template <std::meta::info scope = std::meta::access_context::current().scope()>
@@ -30,19 +51,17 @@ struct FunctionScope {
   template <typename... Ts>
   static std::array<Field, max_idx> capture_args(Ts&&... args) {
     std::array<Field, max_idx> arguments;
-    std::size_t unnamed_count = 0;
 
     template for (constexpr auto Idx : std::views::iota(0ZU, max_idx)) {
       constexpr static auto param = parameters_of(scope)[Idx];
+      constexpr static auto name  = _impl::parameter_name(scope, Idx);
 
       typename[:type_of(param):]* ptr = nullptr;
       if constexpr (sizeof...(Ts) >= Idx) {
         ptr = args...[Idx];
       }
 
-      arguments[Idx] = Field(has_identifier(param) ? identifier_of(param)
-                                                   : "unnamed_" + rsl::util::utos(unnamed_count++),
-                             ptr);
+      arguments[Idx] = Field(name, ptr);
     }
 
     return arguments;
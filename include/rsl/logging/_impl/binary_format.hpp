@@ -0,0 +1,96 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+
+// On-disk layout of BinaryFileSink logs
+//
+// file     := header record*
+// header   := magic[8] u32(version) u32(byte_order)
+// record   := u32(payload size) u8(kind) payload
+//
+// STRING   := u32(id) str
+// CALLSITE := u32(id) u32(file) u32(function) u32(line)
+// EVENT    := u32(callsite) u8(severity) i64(unix ns) u64(thread) u64(context id)
+//             u32(context name) str(text) fields(arguments) fields(context extra)
+// CONTEXT  := u8(entered) u8(handover) i64(unix ns) u64(thread) u64(context id)
+//             u32(context name) u32(callsite) fields(arguments) fields(extra)
+//
+// fields   := u16(count) (u32(name) u32(type) str(value))*
+// str      := u32(size) bytes
+//
+// STRING and CALLSITE records form the dictionary. Every id is defined before the first record
+// referring to it, so the file can be decoded in a single streaming pass. Integers are stored in
+// host byte order, `byte_order` lets readers detect foreign files.
+
+namespace rsl::logging::_impl::binary {
+constexpr inline char magic[8]           = {'R', 'S', 'L', 'L', 'O', 'G', '\0', '\1'};
+constexpr inline std::uint32_t version    = 1;
+constexpr inline std::uint32_t byte_order = 0x01020304;
+
+constexpr inline std::size_t header_size        = sizeof(magic) + 2 * sizeof(std::uint32_t);
+constexpr inline std::size_t record_header_size = sizeof(std::uint32_t) + sizeof(std::uint8_t);
+
+enum class RecordKind : std::uint8_t { STRING = 1, CALLSITE = 2, EVENT = 3, CONTEXT = 4 };
+
+struct Writer {
+  std::string& out;
+
+  template <typename T>
+  void put(T value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.append(bytes, sizeof(T));
+  }
+
+  void put(std::string_view value) {
+    put(static_cast<std::uint32_t>(value.size()));
+    out.append(value);
+  }
+
+  // reserves the record header, returns its offset for `end_record`
+  std::size_t begin_record(RecordKind kind) {
+    auto offset = out.size();
+    put(std::uint32_t{0});
+    put(static_cast<std::uint8_t>(kind));
+    return offset;
+  }
+
+  void end_record(std::size_t offset) {
+    auto size = static_cast<std::uint32_t>(out.size() - offset - record_header_size);
+    std::memcpy(out.data() + offset, &size, sizeof(size));
+  }
+};
+
+struct Reader {
+  std::span<char const> data;
+  std::size_t offset = 0;
+  bool ok            = true;
+
+  template <typename T>
+  T get() {
+    T value{};
+    if (offset + sizeof(T) > data.size()) {
+      ok = false;
+      return value;
+    }
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+  }
+
+  std::string_view get_string() {
+    auto size = get<std::uint32_t>();
+    if (not ok || offset + size > data.size()) {
+      ok = false;
+      return {};
+    }
+    auto value = std::string_view(data.data() + offset, size);
+    offset += size;
+    return value;
+  }
+};
+}  // namespace rsl::logging::_impl::binary
@@ -1,4 +1,6 @@
 #pragma once
+#include <thread>
+
 #include <rsl/logging/flavor/default.hpp>
 #include <rsl/logging/level.hpp>
 #include <rsl/logging/event.hpp>
@@ -34,10 +36,24 @@ void set_output(Output<Sinks...>& sinks){
   selected_logger<Empty...>.set_output(sinks);
 }
 
+// Whether context events for coroutine handovers are wanted. Loggers that cannot tell get them.
+template <typename... Empty>
+bool handover_subscribed() {
+  auto const& logger = rsl::_log_impl::customization<^^selected_logger, Empty...>;
+  if constexpr (requires { logger.wants_handover(); }) {
+    return logger.wants_handover();
+  } else {
+    return true;
+  }
+}
+
 template <typename... Empty>
 void emit_context(Context const& ctx, bool entered, bool async_handover) {
   // ensure pack is empty
-  rsl::_log_impl::customization<^^selected_logger, Empty...>.context(Metadata{.context=ctx}, entered, async_handover);
+  auto meta = Metadata{.timestamp = Timestamp::now(),
+                       .thread_id = std::this_thread::get_id(),
+                       .context   = ctx};
+  rsl::_log_impl::customization<^^selected_logger, Empty...>.context(meta, entered, async_handover);
 }
 
 }  // namespace rsl::logging
\ No newline at end of file
@@ -0,0 +1,166 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <rsl/format>
+
+namespace rsl::logging {
+// Types which refer to storage they do not own. Capturing them for deferred formatting would
+// read the referenced data after the log call returned. Specialize this for custom view types.
+template <typename T>
+constexpr inline bool is_borrowed_v = std::is_pointer_v<T> || std::is_member_pointer_v<T>;
+
+template <typename C, typename Traits>
+constexpr inline bool is_borrowed_v<std::basic_string_view<C, Traits>> = true;
+
+template <typename T, std::size_t Extent>
+constexpr inline bool is_borrowed_v<std::span<T, Extent>> = true;
+
+template <typename T>
+constexpr inline bool is_borrowed_v<std::reference_wrapper<T>> = true;
+
+namespace _impl {
+// String literals are arrays and copied as such. A `char const*` is rejected like any other
+// pointer, even if it points to a literal - wrap it in a std::string.
+template <typename T>
+concept deferrable = not is_borrowed_v<std::remove_cvref_t<T>>;
+
+// owning copy of a single argument, handed back to `make_message` as `T&&`
+template <typename T>
+struct Captured {
+  std::remove_cvref_t<T> value;
+
+  explicit Captured(T&& value) : value(std::forward<T>(value)) {}
+  T&& get() { return static_cast<T&&>(value); }
+};
+
+template <typename T, std::size_t N>
+struct Captured<T (&)[N]> {
+  std::remove_cv_t<T> value[N];
+
+  explicit Captured(T (&value)[N]) { std::ranges::copy(value, this->value); }
+  T (&get())[N] { return value; }
+};
+
+template <typename... Args>
+struct DeferredArgs {
+  format_result (*make_message)(Args&&...);
+  std::tuple<Captured<Args>...> args;
+
+  format_result render() {
+    return std::apply([&](auto&... captured) { return make_message(captured.get()...); }, args);
+  }
+};
+
+// Type-erased record of a `make_message` instantiation and the arguments to call it with.
+// Small argument packs are stored inline, larger ones spill to the heap.
+class DeferredMessage {
+  constexpr static std::size_t inline_capacity = 64;
+
+  struct VTable {
+    format_result (*render)(void* record);
+    void (*destroy)(void* record, bool inline_storage);
+    void (*relocate)(void* from, void* to);
+  };
+
+  template <typename Record>
+  constexpr static VTable const* make_vtable() {
+    static constexpr VTable table{
+        .render  = [](void* record) { return static_cast<Record*>(record)->render(); },
+        .destroy =
+            [](void* record, bool inline_storage) {
+              if (inline_storage) {
+                static_cast<Record*>(record)->~Record();
+              } else {
+                delete static_cast<Record*>(record);
+              }
+            },
+        .relocate =
+            [](void* from, void* to) {
+              auto* source = static_cast<Record*>(from);
+              ::new (to) Record(std::move(*source));
+              source->~Record();
+            }};
+    return &table;
+  }
+
+  VTable const* vtable = nullptr;
+  void* record         = nullptr;
+  alignas(std::max_align_t) std::byte buffer[inline_capacity];
+
+  [[nodiscard]] bool is_inline() const { return record == static_cast<void const*>(buffer); }
+
+  void take(DeferredMessage& other) noexcept {
+    vtable = std::exchange(other.vtable, nullptr);
+    if (other.is_inline()) {
+      record = buffer;
+      vtable->relocate(other.buffer, buffer);
+    } else {
+      record = other.record;
+    }
+    other.record = nullptr;
+  }
+
+  void reset() {
+    if (vtable != nullptr) {
+      vtable->destroy(record, is_inline());
+    }
+    vtable = nullptr;
+    record = nullptr;
+  }
+
+public:
+  DeferredMessage() = default;
+
+  template <typename... Args>
+  explicit DeferredMessage(format_result (*make_message)(Args&&...), Args&&... args) {
+    static_assert((deferrable<Args> && ...),
+                  "Deferred formatting cannot capture pointers or views - the referenced data "
+                  "may not outlive the log call. Pass an owning type (ie. std::string) instead.");
+
+    using Record = DeferredArgs<Args...>;
+    vtable       = make_vtable<Record>();
+    if constexpr (sizeof(Record) <= inline_capacity &&
+                  alignof(Record) <= alignof(std::max_align_t) &&
+                  std::is_nothrow_move_constructible_v<Record>) {
+      record = ::new (static_cast<void*>(buffer))
+          Record{make_message, {Captured<Args>(std::forward<Args>(args))...}};
+    } else {
+      record = new Record{make_message, {Captured<Args>(std::forward<Args>(args))...}};
+    }
+  }
+
+  DeferredMessage(DeferredMessage&& other) noexcept {
+    if (other.vtable != nullptr) {
+      take(other);
+    }
+  }
+
+  DeferredMessage& operator=(DeferredMessage&& other) noexcept {
+    if (this != &other) {
+      reset();
+      if (other.vtable != nullptr) {
+        take(other);
+      }
+    }
+    return *this;
+  }
+
+  DeferredMessage(DeferredMessage const&)            = delete;
+  DeferredMessage& operator=(DeferredMessage const&) = delete;
+
+  ~DeferredMessage() { reset(); }
+
+  explicit operator bool() const { return vtable != nullptr; }
+
+  [[nodiscard]] format_result render() const { return vtable->render(record); }
+};
+}  // namespace _impl
+}  // namespace rsl::logging
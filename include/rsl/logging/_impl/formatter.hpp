@@ -15,6 +15,7 @@
 #include <rsl/logging/event.hpp>
 #include <rsl/logging/context.hpp>
 #include <rsl/logging/field.hpp>
+#include <rsl/logging/callsite.hpp>
 
 namespace rsl::logging {
 namespace _impl {
@@ -27,6 +28,7 @@ template <LogLevel Level, typename... Args>
 struct FormatString {
   using meta_t        = format_result (*)(Args&&...);
   meta_t make_message = nullptr;
+  Callsite* callsite   = &disabled_callsite;
 
   rsl::source_location sloc;
   // TODO source_context
@@ -37,6 +39,15 @@ struct FormatString {
           substitute(^^_impl::make_message,
                      {std::meta::reflect_constant(rsl::string_view(std::define_static_string(fmt))),
                       ^^Args...}));
+      callsite = &extract<Callsite&>(substitute(
+          ^^_impl::callsite,
+          {reflect_constant(Level),
+           reflect_constant(Ctx),
+           reflect_constant(rsl::string_view(std::define_static_string(fmt))),
+           reflect_constant(rsl::string_view(std::define_static_string(std::string_view(sloc.file)))),
+           reflect_constant(static_cast<std::uint32_t>(sloc.line)),
+           reflect_constant(
+               rsl::string_view(std::define_static_string(std::string_view(sloc.function))))}));
     }
   }
   using initialize_t = void (FormatString::*)(std::string_view, rsl::source_location);
@@ -66,16 +77,27 @@ void emit_event(ExtraFields const* fnc_args,
   // we've already checked against global_min_level in FormatString's ctor
   // do it again here to avoid instantiating `emit`
   if constexpr (Level >= global_min_level) {
+    // runtime overrides and the per-callsite switch, cached in a single byte
+    if (not fmt.callsite->is_enabled()) {
+      return;
+    }
+    // nothing the current output could accept
+    if constexpr (requires { selected_logger<Empty...>.accepts(Level); }) {
+      if (not selected_logger<Empty...>.accepts(Level)) {
+        return;
+      }
+    }
     // check context level override
-    if (context != nullptr && Level < context->min_level) {
+    if (context != nullptr && not context->enabled_for(Level)) {
       return;
     }
     auto meta = Metadata{.severity  = Level,
-                         .timestamp = std::chrono::system_clock::now(),
+                         .timestamp = Timestamp::now(),
                          .thread_id = std::this_thread::get_id(),
-                         .context   = context ? *context : Context(),
-                         .arguments = fnc_args ? *fnc_args : ExtraFields{},
-                         .sloc      = fmt.sloc};
+                         .context   = context,
+                         .arguments = fnc_args,
+                         .sloc      = fmt.sloc,
+                         .callsite  = fmt.callsite};
 
     selected_logger<Empty...>.emit(meta, fmt, std::forward<Args>(args)...);
   }
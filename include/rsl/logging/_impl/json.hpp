@@ -0,0 +1,171 @@
+#pragma once
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <format>
+#include <iterator>
+#include <meta>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <rsl/repr>
+
+namespace rsl::logging::_impl::json {
+inline void write_string(std::string& out, std::string_view value) {
+  constexpr char hex[] = "0123456789abcdef";
+  out += '"';
+  for (char c : value) {
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      case '\r': out += "\\r"; break;
+      case '\t': out += "\\t"; break;
+      case '\b': out += "\\b"; break;
+      case '\f': out += "\\f"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out += "\\u00";
+          out += hex[(static_cast<unsigned char>(c) >> 4U) & 0xFU];
+          out += hex[static_cast<unsigned char>(c) & 0xFU];
+        } else {
+          out += c;
+        }
+    }
+  }
+  out += '"';
+}
+
+template <typename T>
+void write_number(std::string& out, T value) {
+  if constexpr (std::floating_point<T>) {
+    if (not std::isfinite(value)) {
+      out += "null";
+      return;
+    }
+  }
+  char buffer[64];
+  auto [end, ec] = std::to_chars(std::begin(buffer), std::end(buffer), value);
+  out.append(buffer, end);
+}
+
+template <typename T>
+constexpr inline bool is_optional = false;
+
+template <typename T>
+constexpr inline bool is_optional<std::optional<T>> = true;
+
+template <typename T>
+concept string_like = std::convertible_to<T const&, std::string_view>;
+
+template <typename T>
+concept map_like = std::ranges::input_range<T const> && requires(std::ranges::range_value_t<T> v) {
+  { v.first } -> string_like;
+  v.second;
+};
+
+template <typename T>
+void write(std::string& out, T const& value);
+
+template <typename T>
+void write_enum(std::string& out, T value) {
+  template for (constexpr auto enumerator : std::define_static_array(enumerators_of(^^T))) {
+    if (value == [:enumerator:]) {
+      write_string(out, identifier_of(enumerator));
+      return;
+    }
+  }
+  // not a named enumerator, ie. a combination of flags
+  write_number(out, std::to_underlying(value));
+}
+
+template <typename T>
+void write_object(std::string& out, T const& value) {
+  out += '{';
+  bool first = true;
+  template for (constexpr auto member : std::define_static_array(
+                    nonstatic_data_members_of(^^T, std::meta::access_context::current()))) {
+    if constexpr (has_identifier(member)) {
+      if (not first) {
+        out += ',';
+      }
+      first = false;
+      write_string(out, identifier_of(member));
+      out += ':';
+      write(out, value.[:member:]);
+    }
+  }
+  out += '}';
+}
+
+// Appends the JSON representation of `value` to `out`.
+// Strings, numbers, booleans, enums (by enumerator name), optionals, pointers, ranges and
+// map-like ranges are mapped to their natural JSON counterparts. Other class types are encoded
+// as objects of their accessible data members. Anything else falls back to its string form.
+template <typename T>
+void write(std::string& out, T const& value) {
+  if constexpr (std::same_as<T, bool>) {
+    out += value ? "true" : "false";
+  } else if constexpr (std::same_as<T, char>) {
+    write_string(out, std::string_view(&value, 1));
+  } else if constexpr (std::integral<T> || std::floating_point<T>) {
+    write_number(out, value);
+  } else if constexpr (std::is_enum_v<T>) {
+    write_enum(out, value);
+  } else if constexpr (std::same_as<T, std::nullptr_t>) {
+    out += "null";
+  } else if constexpr (string_like<T>) {
+    write_string(out, std::string_view(value));
+  } else if constexpr (is_optional<T>) {
+    if (value.has_value()) {
+      write(out, *value);
+    } else {
+      out += "null";
+    }
+  } else if constexpr (std::is_pointer_v<T>) {
+    if (value == nullptr) {
+      out += "null";
+    } else if constexpr (std::is_void_v<std::remove_cv_t<std::remove_pointer_t<T>>> ||
+                         std::is_function_v<std::remove_pointer_t<T>>) {
+      write_string(out, std::format("{}", static_cast<void const*>(value)));
+    } else {
+      write(out, *value);
+    }
+  } else if constexpr (map_like<T>) {
+    out += '{';
+    bool first = true;
+    for (auto const& [key, element] : value) {
+      if (not first) {
+        out += ',';
+      }
+      first = false;
+      write_string(out, std::string_view(key));
+      out += ':';
+      write(out, element);
+    }
+    out += '}';
+  } else if constexpr (std::ranges::input_range<T const>) {
+    out += '[';
+    bool first = true;
+    for (auto const& element : value) {
+      if (not first) {
+        out += ',';
+      }
+      first = false;
+      write(out, element);
+    }
+    out += ']';
+  } else if constexpr (std::is_class_v<T> && not std::is_union_v<T>) {
+    write_object(out, value);
+  } else if constexpr (std::formattable<T, char>) {
+    write_string(out, std::format("{}", value));
+  } else {
+    write_string(out, rsl::repr(value));
+  }
+}
+}  // namespace rsl::logging::_impl::json
@@ -0,0 +1,83 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace rsl::logging::_impl {
+constexpr inline std::size_t cache_line = 64;
+
+// Bounded lock-free single-producer single-consumer queue.
+// `try_emplace` may only be called from the producer thread, `front` and `pop` only from the
+// consumer thread. `empty` may be called from anywhere.
+template <typename T>
+class SpscRing {
+  struct Slot {
+    alignas(T) std::byte storage[sizeof(T)];
+  };
+
+  std::size_t mask;
+  std::unique_ptr<Slot[]> slots;
+
+  alignas(cache_line) std::atomic<std::size_t> head{0};
+  std::size_t cached_tail = 0;  // consumer-local
+
+  alignas(cache_line) std::atomic<std::size_t> tail{0};
+  std::size_t cached_head = 0;  // producer-local
+
+  T* slot(std::size_t idx) { return std::launder(reinterpret_cast<T*>(slots[idx & mask].storage)); }
+
+public:
+  explicit SpscRing(std::size_t capacity)
+      : mask(std::bit_ceil(capacity) - 1)
+      , slots(std::make_unique<Slot[]>(mask + 1)) {}
+
+  SpscRing(SpscRing const&)            = delete;
+  SpscRing& operator=(SpscRing const&) = delete;
+
+  ~SpscRing() {
+    while (front() != nullptr) {
+      pop();
+    }
+  }
+
+  [[nodiscard]] std::size_t capacity() const { return mask + 1; }
+
+  template <typename... Args>
+  bool try_emplace(Args&&... args) {
+    auto const current = tail.load(std::memory_order_relaxed);
+    if (current - cached_head == capacity()) {
+      cached_head = head.load(std::memory_order_acquire);
+      if (current - cached_head == capacity()) {
+        return false;
+      }
+    }
+    ::new (static_cast<void*>(slots[current & mask].storage)) T(std::forward<Args>(args)...);
+    tail.store(current + 1, std::memory_order_release);
+    return true;
+  }
+
+  T* front() {
+    auto const current = head.load(std::memory_order_relaxed);
+    if (current == cached_tail) {
+      cached_tail = tail.load(std::memory_order_acquire);
+      if (current == cached_tail) {
+        return nullptr;
+      }
+    }
+    return slot(current);
+  }
+
+  void pop() {
+    auto const current = head.load(std::memory_order_relaxed);
+    slot(current)->~T();
+    head.store(current + 1, std::memory_order_release);
+  }
+
+  [[nodiscard]] bool empty() const {
+    return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+  }
+};
+}  // namespace rsl::logging::_impl
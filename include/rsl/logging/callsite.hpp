@@ -0,0 +1,107 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <meta>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <rsl/format>
+
+#include "level.hpp"
+
+namespace rsl::logging {
+// Static descriptor of a single log statement. Every callsite registers itself the first time
+// it runs and can be switched on or off individually afterwards.
+//
+// `threshold` fuses the enabled flag, the runtime overrides of the enclosing scope and the
+// compile-time annotations into a single byte, so checking a callsite is one relaxed load and
+// a compare. 0 means not resolved yet, `LogLevel::DISABLE` turns the callsite off.
+struct Callsite {
+  LogLevel level;
+  std::string_view format;
+  std::string_view file;
+  std::uint32_t line;
+  std::string_view function;
+
+  // qualified name of the enclosing scope, used to look up runtime overrides
+  std::string_view scope;
+  LogLevel static_level;
+
+  std::atomic<std::uint8_t> threshold{0};
+  std::atomic<bool> enabled{true};
+  std::atomic<bool> registered{false};
+  Callsite* next = nullptr;
+
+  constexpr Callsite(LogLevel level,
+                     std::string_view format,
+                     std::string_view file,
+                     std::uint32_t line,
+                     std::string_view function,
+                     std::string_view scope,
+                     LogLevel static_level,
+                     std::uint8_t threshold = 0)
+      : level(level)
+      , format(format)
+      , file(file)
+      , line(line)
+      , function(function)
+      , scope(scope)
+      , static_level(static_level)
+      , threshold(threshold) {}
+
+  Callsite(Callsite const&)            = delete;
+  Callsite& operator=(Callsite const&) = delete;
+
+  [[nodiscard]] bool is_enabled() {
+    auto const current = threshold.load(std::memory_order_relaxed);
+    if (std::to_underlying(level) < current) {
+      return false;
+    }
+    return current != 0 || resolve();
+  }
+
+  void enable() { set_enabled(true); }
+  void disable() { set_enabled(false); }
+  void set_enabled(bool value);
+
+private:
+  // registers the callsite and computes its threshold, returns whether it is enabled
+  bool resolve();
+};
+
+// every callsite that ran at least once, in no particular order
+std::vector<Callsite*> callsites();
+
+namespace _impl {
+// called after the runtime overrides changed, makes every callsite resolve again
+void invalidate_callsites();
+
+// qualified name of the innermost named scope, ie. `foo::bar::Baz::run`
+consteval std::string_view scope_path(std::meta::info scope) {
+  std::string path;
+  while (scope != ^^::) {
+    if ((is_namespace(scope) || is_type(scope) || is_function(scope)) && has_identifier(scope)) {
+      auto name = std::string(identifier_of(scope));
+      path      = path.empty() ? name : name + "::" + path;
+    }
+    scope = parent_of(scope);
+  }
+  return std::define_static_string(path);
+}
+
+template <LogLevel Level,
+          std::meta::info Scope,
+          rsl::string_view Fmt,
+          rsl::string_view File,
+          std::uint32_t Line,
+          rsl::string_view Function>
+constinit inline Callsite callsite{
+    Level, Fmt, File, Line, Function, scope_path(Scope), min_level_for(Scope)};
+
+// callsites removed at compile time never pass
+constinit inline Callsite disabled_callsite{
+    LogLevel::INHERIT, "", "", 0, "", "", LogLevel::DISABLE, std::to_underlying(LogLevel::DISABLE)};
+}  // namespace _impl
+}  // namespace rsl::logging
@@ -0,0 +1,117 @@
+#pragma once
+#include <chrono>
+#include <compare>
+#include <cstdint>
+#include <format>
+
+#if defined(__x86_64__) || defined(__i386__)
+#  include <x86intrin.h>
+#endif
+
+// Event timestamps
+//
+// By default `Timestamp` holds unix nanoseconds read from `system_clock`. Defining
+// RSL_LOG_TSC_CLOCK (CMake option `TSC_CLOCK`) makes it hold raw cycle counter ticks instead,
+// which are converted to wall-clock time only when a sink renders them. The conversion is
+// calibrated against `system_clock` on first use and refreshed by a background thread. Refreshes
+// steer the conversion towards the wall clock but never move a converted time backwards.
+// This assumes an invariant TSC, which is the case on every x86 CPU of the last decade.
+//
+// The macro changes the meaning of stored timestamps, it must be set consistently for the
+// library and its consumers.
+
+namespace rsl::logging {
+namespace _impl {
+// raw value of the cheapest monotonic counter available
+inline std::int64_t read_ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+  return static_cast<std::int64_t>(__rdtsc());
+#elif defined(__aarch64__)
+  std::int64_t ticks;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+  return ticks;
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+// Nanoseconds for measuring intervals, ie. in filters. Unlike event timestamps they are not
+// affected by steps of the wall clock.
+inline std::int64_t steady_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+std::int64_t ticks_to_unix_ns(std::int64_t ticks);
+std::int64_t unix_ns_to_ticks(std::int64_t unix_ns);
+// refreshes the tick conversion now rather than on the background thread's schedule
+void recalibrate_clock();
+}  // namespace _impl
+
+class Timestamp {
+  // ticks with RSL_LOG_TSC_CLOCK, unix nanoseconds otherwise
+  std::int64_t value = 0;
+
+  static std::int64_t to_value(std::int64_t unix_ns) {
+#ifdef RSL_LOG_TSC_CLOCK
+    return _impl::unix_ns_to_ticks(unix_ns);
+#else
+    return unix_ns;
+#endif
+  }
+
+public:
+  using time_point = std::chrono::system_clock::time_point;
+
+  Timestamp() = default;
+  explicit(false) Timestamp(time_point timestamp)
+      : value(to_value(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           timestamp.time_since_epoch())
+                           .count())) {}
+
+  static Timestamp now() {
+    Timestamp timestamp;
+#ifdef RSL_LOG_TSC_CLOCK
+    timestamp.value = _impl::read_ticks();
+#else
+    timestamp.value = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+#endif
+    return timestamp;
+  }
+
+  [[nodiscard]] std::int64_t raw() const { return value; }
+
+  [[nodiscard]] std::int64_t unix_ns() const {
+#ifdef RSL_LOG_TSC_CLOCK
+    return _impl::ticks_to_unix_ns(value);
+#else
+    return value;
+#endif
+  }
+
+  [[nodiscard]] time_point to_sys() const {
+    return time_point(std::chrono::duration_cast<time_point::duration>(
+        std::chrono::nanoseconds(unix_ns())));
+  }
+
+  explicit(false) operator time_point() const { return to_sys(); }
+
+  // raw values are monotonic within a process, comparing does not need a conversion
+  auto operator<=>(Timestamp const&) const = default;
+};
+}  // namespace rsl::logging
+
+template <typename CharT>
+struct std::formatter<rsl::logging::Timestamp, CharT>
+    : std::formatter<std::chrono::system_clock::time_point, CharT> {
+  template <typename FmtContext>
+  auto format(rsl::logging::Timestamp const& timestamp, FmtContext& ctx) const {
+    return std::formatter<std::chrono::system_clock::time_point, CharT>::format(timestamp.to_sys(),
+                                                                                ctx);
+  }
+};
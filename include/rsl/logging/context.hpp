@@ -1,26 +1,70 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <coroutine>
 
 #include <rsl/source_location>
 #include <rsl/_impl/consumable.hpp>
 #include "level.hpp"
 #include "field.hpp"
+#include "ids.hpp"
 
 namespace rsl::logging {
 struct Context;
 template <typename... Empty>
 void emit_context(Context const& meta, bool entered, bool async_handover);
+template <typename... Empty>
+bool handover_subscribed();
+
+namespace _impl {
+// bumped whenever the level of any context changes, invalidating all cached effective levels
+extern std::atomic<std::uint64_t> context_epoch;
+
+// effective level together with the epoch it was computed in, packed so it can be read with a
+// single load. Copies take a snapshot of the value.
+struct CachedLevel {
+  std::atomic<std::uint64_t> value{0};
+
+  CachedLevel() = default;
+  CachedLevel(CachedLevel const& other) : value(other.value.load(std::memory_order_relaxed)) {}
+  CachedLevel& operator=(CachedLevel const& other) {
+    value.store(other.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+  }
+
+  [[nodiscard]] static constexpr std::uint64_t pack(std::uint64_t epoch, LogLevel level) {
+    return (epoch << 8U) | std::to_underlying(level);
+  }
+};
+}  // namespace _impl
 
 struct RSL_CONSUMABLE(unconsumed) Context {
+  // The contexts entered on a thread form an intrusive doubly linked stack, so a context can
+  // be exited in O(1) regardless of its position. `owner` identifies the thread it was entered
+  // on. The shared default context is never linked to, it only ever appears as a parent.
   Context* parent    = nullptr;
+  Context* child     = nullptr;
+  void const* owner  = nullptr;
   LogLevel min_level = LogLevel::INHERIT;
-  std::size_t id     = 0;
+  // span ID, random per `next_id`
+  std::uint64_t id   = 0;
+  // Inherited from the parent on entry unless set, a new trace is started if the parent has
+  // none. `remote_parent` is the span ID of a parent in another process, see
+  // `extract_traceparent`.
+  TraceId trace_id;
+  std::uint64_t remote_parent = 0;
+  std::uint8_t trace_flags    = TraceParent::sampled;
   std::string name;
   ExtraFields arguments;
   ExtraFields extra;
   rsl::source_location sloc;
 
+  // see `effective_level`
+  mutable _impl::CachedLevel cached_level;
+
   Context() = default;
 
   RSL_RETURN_TYPESTATE(unconsumed)
@@ -40,18 +84,34 @@ struct RSL_CONSUMABLE(unconsumed) Context {
 
   [[nodiscard]] Context clone() const {
     Context cloned{};
-    cloned.parent    = nullptr;
-    cloned.min_level = min_level;
-    cloned.id        = id;
-    cloned.name      = name;
-    cloned.arguments = arguments.clone();
-    cloned.extra     = extra.clone();
+    cloned.parent        = nullptr;
+    cloned.child         = nullptr;
+    cloned.owner         = nullptr;
+    cloned.min_level     = min_level;
+    cloned.id            = id;
+    cloned.trace_id      = trace_id;
+    cloned.remote_parent = remote_parent;
+    cloned.trace_flags   = trace_flags;
+    cloned.name          = name;
+    cloned.arguments     = arguments.clone();
+    cloned.extra         = extra.clone();
+    cloned.sloc          = sloc;
     return cloned;
   }
 
-  static std::size_t next_id();
+  static std::uint64_t next_id();
   static Context* get_default();
 
+  // number of exits of contexts that were not active on the exiting thread
+  static std::uint64_t foreign_exits();
+
+  // Unlinks the contexts above `base` on the calling thread's stack and returns the innermost,
+  // nullptr if `base` is current or not on the stack. Detached contexts may still be exited,
+  // ie. when a suspended coroutine is destroyed.
+  static Context* detach_above(Context const* base);
+  // Links a segment returned by `detach_above` onto the calling thread's current context.
+  static void attach(Context* top);
+
   template <typename... E>
   RSL_CALLABLE_WHEN(unconsumed)
   RSL_SET_TYPESTATE(consumed) void enter(bool handover = false) {
@@ -67,9 +127,30 @@ struct RSL_CONSUMABLE(unconsumed) Context {
     }
   }
 
-  [[nodiscard]] bool enabled_for(LogLevel level) const;
+  // Level this context filters by: its own `min_level` or, if that is INHERIT, the effective
+  // level of its parent. Contexts without a parent inherit from the default context.
+  // The result is cached when the context is entered and recomputed only after a level changed
+  // anywhere, so the common case is two relaxed loads.
+  [[nodiscard]] LogLevel effective_level() const {
+    auto const epoch  = _impl::context_epoch.load(std::memory_order_acquire);
+    auto const cached = cached_level.value.load(std::memory_order_relaxed);
+    if ((cached >> 8U) == epoch) {
+      return LogLevel(cached & 0xFFU);
+    }
+    return refresh_level(epoch);
+  }
+
+  [[nodiscard]] bool enabled_for(LogLevel level) const { return level >= effective_level(); }
+
+  // Changes the level and invalidates the cached effective level of every context. Other
+  // threads observe the new level on their next event.
+  void set_min_level(LogLevel level);
 
 private:
+  LogLevel refresh_level(std::uint64_t epoch) const;
+  // refreshes the cached levels of `from` and the contexts further out inheriting from it
+  static void refresh_inherited(Context* from);
+
   RSL_CALLABLE_WHEN(unconsumed)
   RSL_SET_TYPESTATE(consumed)
   void activate();
@@ -81,6 +162,24 @@ private:
 
 extern thread_local Context* current_context;
 
+// `traceparent` value identifying `context` as the parent of spans in other processes
+[[nodiscard]] inline std::string inject_traceparent(Context const& context) {
+  return TraceParent{context.trace_id, context.id, context.trace_flags}.to_string();
+}
+
+// Makes `context` continue the trace described by `traceparent`. Must be called before the
+// context is entered. Returns false and leaves `context` untouched if the value is malformed.
+inline bool extract_traceparent(std::string_view traceparent, Context& context) {
+  auto const parsed = TraceParent::parse(traceparent);
+  if (not parsed.has_value()) {
+    return false;
+  }
+  context.trace_id      = parsed->trace_id;
+  context.remote_parent = parsed->parent_id;
+  context.trace_flags   = parsed->flags;
+  return true;
+}
+
 template <typename T = std::monostate>
 struct ContextGuard : private Context {
   T extra_data;
@@ -93,7 +192,8 @@ struct ContextGuard : private Context {
       : Context(name, min_level, arguments, {}, sloc)
       , extra_data(extra_fields) {
     if constexpr (not std::same_as<T, std::monostate>) {
-      extra = ExtraFields(extra_fields);
+      // refer to our own copy, `extra_fields` is gone once the constructor returns
+      extra = ExtraFields(extra_data);
     }
     enter<T>();
   }
@@ -126,8 +226,42 @@ decltype(auto) to_awaiter(T&& t) {
   }
 }
 
+// Coroutine handover: the contexts a coroutine entered since it last resumed are unlinked from
+// the thread's stack when it suspends and linked onto the resuming thread's stack as they are.
+// Nothing is copied or allocated, the contexts keep their ids. `caller` is the context that was
+// current when the coroutine (re)started, everything above it belongs to the coroutine.
+struct Handover {
+  Context* caller    = current_context;
+  Context* suspended = nullptr;
+  bool detached      = false;
+
+  template <typename... E>
+  void suspend() {
+    if (current_context != caller && handover_subscribed<E...>()) {
+      emit_context<E...>(*current_context, false, true);
+    }
+    suspended = Context::detach_above(caller);
+    detached  = true;
+  }
+
+  template <typename... E>
+  void resume() {
+    if (not std::exchange(detached, false)) {
+      // the awaitable was ready, nothing was handed over
+      return;
+    }
+    caller = current_context;
+    if (suspended != nullptr) {
+      Context::attach(std::exchange(suspended, nullptr));
+      if (handover_subscribed<E...>()) {
+        emit_context<E...>(*current_context, true, true);
+      }
+    }
+  }
+};
+
 template <typename Awaitable, typename Promise>
-  requires(requires(Promise* p) { p->saved_span; })
+  requires(requires(Promise* p) { p->handover; })
 struct AwaiterWrapper {
   Awaitable original;
   Promise* promise;
@@ -138,14 +272,35 @@ struct AwaiterWrapper {
 
   template <typename H>
   decltype(auto) await_suspend(H h) noexcept(noexcept(to_awaiter(original).await_suspend(h))) {
-    promise->saved_span    = Context{current_context->name, current_context->min_level};
-    promise->saved_span.id = current_context->id;
-    current_context->exit<Awaitable>(true);
+    // before handing `h` on, it may be resumed on another thread right away
+    promise->handover.template suspend<Awaitable>();
     return to_awaiter(original).await_suspend(h);
   }
 
   decltype(auto) await_resume() noexcept(noexcept(to_awaiter(original).await_resume())) {
-    promise->saved_span.template enter<Awaitable>(true);
+    promise->handover.template resume<Awaitable>();
+    return to_awaiter(original).await_resume();
+  }
+};
+
+// a lazily started coroutine runs first on whichever thread resumes it
+template <typename Awaitable, typename Promise>
+struct InitialAwaiter {
+  Awaitable original;
+  Promise* promise;
+
+  bool await_ready() noexcept(noexcept(to_awaiter(original).await_ready())) {
+    return to_awaiter(original).await_ready();
+  }
+
+  template <typename H>
+  decltype(auto) await_suspend(H h) noexcept(noexcept(to_awaiter(original).await_suspend(h))) {
+    promise->handover.detached = true;
+    return to_awaiter(original).await_suspend(h);
+  }
+
+  decltype(auto) await_resume() noexcept(noexcept(to_awaiter(original).await_resume())) {
+    promise->handover.template resume<Awaitable>();
     return to_awaiter(original).await_resume();
   }
 };
@@ -157,7 +312,12 @@ struct Trace {
 
   struct promise_type : R::promise_type {
     using Base = typename R::promise_type;
-    Context saved_span{};
+    _log_impl::Handover handover;
+
+    auto initial_suspend() noexcept(noexcept(std::declval<Base&>().initial_suspend())) {
+      using Awaitable = decltype(std::declval<Base&>().initial_suspend());
+      return _log_impl::InitialAwaiter<Awaitable, promise_type>{Base::initial_suspend(), this};
+    }
 
     Trace get_return_object() noexcept(noexcept(
         std::coroutine_handle<promise_type>::from_promise(std::declval<promise_type&>()))) {
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <unistd.h>
+
+// Crash handling
+//
+// `install_crash_handler` hooks SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT and std::terminate.
+// When one of them fires, the handler writes a final FATAL line naming the cause and the
+// contexts active on the crashing thread, runs the flush hooks registered by sinks holding
+// buffered data and then re-raises the signal so the process dies as it would have without it.
+// Should another thread crash meanwhile, it waits for the hooks to finish before re-raising.
+//
+// Everything that runs in the handler sticks to preallocated memory and write(2). Hooks may
+// try to take their sink's mutex but must give up after a bounded wait, the crashing thread
+// may hold it. Installing the handler is opt-in, hooks are inert until then.
+
+namespace rsl::logging {
+// `fatal_line` is the final event, already formatted. Hooks append it to their destination
+// after their pending data.
+using CrashHook = void (*)(void* data, std::string_view fatal_line);
+
+// At most 32 hooks can be registered at once, returns false if none is left
+bool register_crash_hook(CrashHook hook, void* data);
+void unregister_crash_hook(CrashHook hook, void* data);
+
+// `fd` additionally receives the final line, -1 to only hand it to the hooks
+void install_crash_handler(int fd = STDERR_FILENO);
+void uninstall_crash_handler();
+
+namespace _impl {
+// Fixed-size line builder for signal handlers, output beyond its capacity is dropped.
+template <std::size_t Capacity>
+struct SignalSafeBuffer {
+  char data[Capacity];
+  std::size_t size = 0;
+
+  SignalSafeBuffer& operator<<(std::string_view text) {
+    for (char c : text) {
+      if (size == Capacity) {
+        break;
+      }
+      data[size++] = c;
+    }
+    return *this;
+  }
+
+  SignalSafeBuffer& operator<<(std::uint64_t value) {
+    char digits[20];
+    std::size_t count = 0;
+    do {
+      digits[count++] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    } while (value != 0);
+    while (count != 0 && size < Capacity) {
+      data[size++] = digits[--count];
+    }
+    return *this;
+  }
+
+  [[nodiscard]] std::string_view view() const { return {data, size}; }
+  void clear() { size = 0; }
+};
+
+// write(2) until done, retrying on EINTR
+void write_all(int fd, std::string_view data);
+
+// Spins on `try_lock` for a bounded time. Other threads keep running while one of them handles
+// a crash, a lock held by them is usually released quickly. The crashing thread itself may hold
+// it though, waiting indefinitely would hang the process.
+template <typename Mutex>
+bool try_lock_briefly(Mutex& mutex) {
+  for (int attempt = 0; attempt < 1'000'000; ++attempt) {
+    if (mutex.try_lock()) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace _impl
+}  // namespace rsl::logging
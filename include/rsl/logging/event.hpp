@@ -1,38 +1,130 @@
 #pragma once
 #include <thread>
 #include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 
 #include <rsl/format>
 #include <rsl/meta_traits>
 #include <rsl/source_location>
 #include <rsl/utility>
 
+#include "callsite.hpp"
+#include "clock.hpp"
 #include "level.hpp"
 #include "context.hpp"
 #include "field.hpp"
 
 namespace rsl::logging {
 
+// Views state owned by the emitting thread - only valid for the duration of a synchronous emit.
+// `pin` replaces the view with a refcounted immutable snapshot which may be retained freely.
+template <typename T>
+class Borrowed {
+  std::shared_ptr<T const> owner;
+  T const* ptr = nullptr;
+
+  static T const& empty() {
+    static T const value{};
+    return value;
+  }
+
+public:
+  Borrowed() = default;
+  explicit(false) Borrowed(T const* ptr) : ptr(ptr) {}
+  explicit(false) Borrowed(T const& ref) : ptr(&ref) {}
+  explicit(false) Borrowed(T&& value)
+      : owner(std::make_shared<T const>(std::move(value)))
+      , ptr(owner.get()) {}
+
+  T const& operator*() const { return ptr != nullptr ? *ptr : empty(); }
+  T const* operator->() const { return &**this; }
+
+  [[nodiscard]] bool is_pinned() const { return owner != nullptr || ptr == nullptr; }
+
+  void pin() {
+    if (not is_pinned()) {
+      owner = std::make_shared<T const>(ptr->clone());
+      ptr   = owner.get();
+    }
+  }
+};
+
 struct Metadata {
   LogLevel severity;
-  std::chrono::system_clock::time_point timestamp;
+  Timestamp timestamp;
   std::thread::id thread_id;
-  Context context;
-  ExtraFields arguments;
+  Borrowed<Context> context;
+  Borrowed<ExtraFields> arguments;
 
   // set by the formatter
   rsl::source_location sloc;
+  Callsite const* callsite = nullptr;
+
+  // required before retaining the metadata past the emit call, ie. in async or buffering sinks
+  void pin() {
+    context.pin();
+    arguments.pin();
+  }
 };
 
-struct Event {
+// The message is rendered on first access of `text()`, events rejected by every filter are
+// never formatted. It is rendered once, every sink reads the same text through a view. A pending renderer refers to the caller's arguments, it is only valid for the
+// duration of a synchronous emit. Copies render first, so they may be retained freely.
+class Event {
+  using renderer_t = format_result (*)(void*);
+
+  mutable std::optional<std::string> rendered;
+  mutable renderer_t renderer = nullptr;
+  void* closure               = nullptr;
+
+  Event(Metadata meta, renderer_t renderer, void* closure)
+      : renderer(renderer)
+      , closure(closure)
+      , meta(std::move(meta)) {}
+
+public:
   Metadata meta;
-  format_result text;
+
+  Event(Metadata meta, format_result text)
+      : rendered(std::string(std::move(text)))
+      , meta(std::move(meta)) {}
+
+  // `render()` is called at most once, when the text is first needed
+  template <typename F>
+    requires std::is_invocable_r_v<format_result, F&>
+  [[nodiscard]] static Event deferred(Metadata meta, F& render) {
+    return {std::move(meta),
+            [](void* closure) -> format_result { return (*static_cast<F*>(closure))(); },
+            static_cast<void*>(std::addressof(render))};
+  }
+
+  Event(Event const& other) : rendered(std::string(other.text())), meta(other.meta) {}
+  Event(Event&& other) noexcept
+      : rendered(std::move(other.rendered))
+      , renderer(std::exchange(other.renderer, nullptr))
+      , closure(std::exchange(other.closure, nullptr))
+      , meta(std::move(other.meta)) {}
+  Event& operator=(Event const&) = delete;
+  Event& operator=(Event&&)      = delete;
+
+  [[=getter]]
+  std::string_view text() const {
+    if (not rendered.has_value()) {
+      rendered.emplace(std::string(std::exchange(renderer, nullptr)(closure)));
+    }
+    return *rendered;
+  }
+
+  [[nodiscard]] bool is_rendered() const { return rendered.has_value(); }
 
   [[=getter]]
   std::uint64_t unix_timestamp() const {
-    return static_cast<std::uint64_t>(
-        std::chrono::duration_cast<std::chrono::milliseconds>(meta.timestamp.time_since_epoch())
-            .count());
+    return static_cast<std::uint64_t>(meta.timestamp.unix_ns() / 1'000'000);
   }
 };
 }  // namespace rsl::logging
\ No newline at end of file
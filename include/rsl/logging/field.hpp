@@ -1,9 +1,13 @@
 #pragma once
 #include <string>
 #include <format>
+#include <iterator>
 #include <type_traits>
 #include <utility>
 #include <vector>
+#include <array>
+#include <algorithm>
+#include <ranges>
 #include <meta>
 #include <atomic>
 
@@ -11,6 +15,8 @@
 #include <rsl/repr>
 #include <rsl/kwargs>
 
+#include "_impl/json.hpp"
+
 namespace rsl::logging {
 class Field {
   template <typename T>
@@ -28,9 +34,11 @@ class Field {
       RefCounted& operator=(RefCounted&&)      = delete;
     };
 
-    static std::string to_string(Field const* field) { return std::format("{}", *get(field)); }
-    static std::string to_repr(Field const* field) { return rsl::repr(*get(field)); }
-    static std::string to_json(Field const* field) { return ""; }
+    static void to_string(Field const* field, std::string& out) {
+      std::format_to(std::back_inserter(out), "{}", *get(field));
+    }
+    static void to_repr(Field const* field, std::string& out) { out += rsl::repr(*get(field)); }
+    static void to_json(Field const* field, std::string& out) { _impl::json::write(out, *get(field)); }
 
     static T* get(Field* field) {
       if (field->vtable->destroy != nullptr) {
@@ -66,9 +74,9 @@ class Field {
   struct VTable {
     std::string_view type_name;
 
-    std::string (*to_string)(Field const*);
-    std::string (*to_repr)(Field const*);
-    std::string (*to_json)(Field const*);
+    void (*to_string)(Field const*, std::string&);
+    void (*to_repr)(Field const*, std::string&);
+    void (*to_json)(Field const*, std::string&);
     Field (*clone)(Field const*);
     void (*destroy)(void* p);
 
@@ -182,50 +190,167 @@ public:
   }
 
   [[nodiscard]] std::string_view type_name() const { return vtable->type_name; }
-  [[nodiscard]] std::string to_string() const { return vtable->to_string(this); }
-  [[nodiscard]] std::string to_json() const { return vtable->to_json(this); }
-  [[nodiscard]] std::string to_repr() const { return vtable->to_repr(this); }
+
+  [[nodiscard]] std::string to_string() const {
+    std::string out;
+    to_string(out);
+    return out;
+  }
+
+  [[nodiscard]] std::string to_repr() const {
+    std::string out;
+    to_repr(out);
+    return out;
+  }
+
+  [[nodiscard]] std::string to_json() const {
+    std::string out;
+    to_json(out);
+    return out;
+  }
+
+  // the following append to `out` instead of returning a new string
+  void to_string(std::string& out) const { vtable->to_string(this, out); }
+  void to_repr(std::string& out) const { vtable->to_repr(this, out); }
+  void to_json(std::string& out) const { vtable->to_json(this, out); }
 };
 
-struct ExtraFields {
-  // TODO this could be a span that views memory on the stack and transitions to heap if its elts do
-  std::vector<Field> fields;
+#ifndef RSL_LOG_INLINE_FIELDS
+#  define RSL_LOG_INLINE_FIELDS 4
+#endif
+
+// Fields are stored inline up to `inline_capacity`, larger sets spill to the heap.
+// Constructing from an array (ie. RSL_LOG_ARGS) only views the caller's storage. Such a view is
+// valid until the end of the full expression - copying or moving it copies the field handles
+// into owned storage. `clone` additionally moves the referenced values to the heap so the result
+// may outlive the values it was created from.
+class ExtraFields {
+public:
+  constexpr static std::size_t inline_capacity = RSL_LOG_INLINE_FIELDS;
+
+private:
+  Field const* data_ = nullptr;
+  std::size_t size_  = 0;
+  std::array<Field, inline_capacity> local;
+  std::vector<Field> heap;
+
+  [[nodiscard]] bool is_inline() const { return data_ == local.data(); }
+
+  void reset() {
+    if (is_inline()) {
+      for (std::size_t idx = 0; idx < size_; ++idx) {
+        local[idx] = Field();
+      }
+    }
+    heap.clear();
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  Field* allocate(std::size_t count) {
+    reset();
+    size_ = count;
+    if (count <= inline_capacity) {
+      data_ = local.data();
+      return local.data();
+    }
+    heap.resize(count);
+    data_ = heap.data();
+    return heap.data();
+  }
+
+  void assign(ExtraFields const& other) {
+    if (other.size_ == 0) {
+      reset();
+      return;
+    }
+    std::ranges::copy(other, allocate(other.size_));
+  }
 
+  void take(ExtraFields&& other) {
+    if (other.is_inline() || other.heap.empty()) {
+      // inline storage and views can't be stolen, copy the handles instead
+      auto* target = allocate(other.size_);
+      if (other.is_inline()) {
+        std::ranges::move(other.local.begin(), other.local.begin() + other.size_, target);
+      } else {
+        std::ranges::copy(other, target);
+      }
+    } else {
+      reset();
+      heap  = std::move(other.heap);
+      data_ = heap.data();
+      size_ = heap.size();
+    }
+    other.reset();
+  }
+
+public:
   ExtraFields() = default;
 
+  // view, see above
   template <std::size_t N>
-  explicit(false) ExtraFields(std::array<Field, N> const& fields) {}
+  explicit(false) ExtraFields(std::array<Field, N> const& fields) : data_(fields.data())
+                                                                  , size_(N) {}
+
+  explicit(false) ExtraFields(std::vector<Field> fields) {
+    if (not fields.empty()) {
+      heap  = std::move(fields);
+      data_ = heap.data();
+      size_ = heap.size();
+    }
+  }
 
-  explicit(false) ExtraFields(std::vector<Field> fields) : fields(std::move(fields)) {}
+  // the fields refer to the members of `kwargs`, which must outlive this container
   template <typename T>
     requires is_kwargs<T>
   explicit(false) ExtraFields(T const& kwargs) {
-    template for (constexpr auto member : std::define_static_array(
-                      nonstatic_data_members_of(^^typename std::remove_cvref_t<T>::type,
-                                                std::meta::access_context::current()))) {
-      static constexpr auto name = std::define_static_string(identifier_of(member));
-      // we need to clone here
-      // the kwargs wrapper will not live long enough, it'll be destroyed
-      // after the full expression in which this container is created
-      fields.push_back(Field(name, &kwargs.[:member:]));
+    constexpr static auto members = std::define_static_array(nonstatic_data_members_of(
+        ^^typename std::remove_cvref_t<T>::type, std::meta::access_context::current()));
+    auto* target = allocate(members.size());
+    template for (constexpr auto Idx : std::views::iota(0ZU, members.size())) {
+      static constexpr auto name = std::define_static_string(identifier_of(members[Idx]));
+      target[Idx]                = Field(name, &kwargs.[:members[Idx]:]);
+    }
+  }
+
+  ExtraFields(ExtraFields const& other) { assign(other); }
+  ExtraFields(ExtraFields&& other) noexcept { take(std::move(other)); }
+
+  ExtraFields& operator=(ExtraFields const& other) {
+    if (this != &other) {
+      assign(other);
     }
+    return *this;
   }
 
-  [[nodiscard]] bool is_empty() const { return fields.empty(); }
-  [[nodiscard]] auto begin() const { return fields.begin(); }
-  [[nodiscard]] auto end() const { return fields.end(); }
+  ExtraFields& operator=(ExtraFields&& other) noexcept {
+    if (this != &other) {
+      take(std::move(other));
+    }
+    return *this;
+  }
+
+  ~ExtraFields() = default;
+
+  [[nodiscard]] bool is_empty() const { return size_ == 0; }
+  [[nodiscard]] std::size_t size() const { return size_; }
+  [[nodiscard]] Field const* begin() const { return data_; }
+  [[nodiscard]] Field const* end() const { return data_ + size_; }
 
   [[nodiscard]] ExtraFields clone() const {
-    std::vector<Field> cloned;
-    cloned.reserve(fields.size());
-    for (auto const& field : fields) {
-      cloned.push_back(field.clone());
+    ExtraFields cloned;
+    if (size_ != 0) {
+      auto* target = cloned.allocate(size_);
+      for (std::size_t idx = 0; idx < size_; ++idx) {
+        target[idx] = data_[idx].clone();
+      }
     }
-    return ExtraFields(std::move(cloned));
+    return cloned;
   }
 
   [[nodiscard]] Field const* get(std::string_view name) const {
-    for (auto const& field : fields) {
+    for (auto const& field : *this) {
       if (field.name == name) {
         return &field;
       }
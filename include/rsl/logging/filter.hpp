@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <tuple>
 #include <type_traits>
 #include <concepts>
@@ -27,9 +28,33 @@ constexpr inline bool will_terminate_impl<Any<Ts...>> = (will_terminate_impl<Ts>
 
 template <typename T>
 concept will_terminate = will_terminate_impl<T>;
+
+// Stages that need to emit events of their own, ie. summaries, receive the rest of the pipeline
+// as a continuation: `bool process_event(Event const&, auto&& next)`. They call `next` for
+// every event that should continue and return its result.
+template <typename T>
+concept continuation_stage = requires(T& stage, Event const& event, bool (*next)(Event const&)) {
+  { stage.process_event(event, next) } -> std::convertible_to<bool>;
+};
+
+// Continuation stages holding back events, ie. summaries, may send them on through
+// `void flush(auto&& next)`.
+template <typename T>
+concept flushing_stage = requires(T& stage, bool (*next)(Event const&)) { stage.flush(next); };
+
+template <typename T>
+constexpr inline bool is_pipeline = false;
+
+template <typename... Ts>
+constexpr inline bool is_pipeline<All<Ts...>> = true;
 }  // namespace _impl
 
+// Every stage reports `min_level()`, a conservative lower bound on the severity of events it
+// may accept. Outputs use it to reject events before any metadata is collected. Stages that
+// cannot tell, which includes arbitrary predicates, report `LogLevel::INHERIT` - no bound.
 struct Filter {
+  [[nodiscard]] constexpr LogLevel min_level() const { return LogLevel::INHERIT; }
+
   template <typename T>
   bool process_event(this T&& self, Event const& event) {
     static_assert(
@@ -82,10 +107,15 @@ struct All {
   All(All<Vs...> rhs, T&& lhs)
       : elts(std::tuple_cat(rhs.elts, std::tuple<T>(std::forward<T>(lhs)))) {}
 
-  bool process_event(Event const& event) {
-    return [&]<std::size_t... Idx>(std::index_sequence<Idx...>) {
-      return (get<Idx>(elts).process_event(event) && ...);
-    }(std::index_sequence_for<Ts...>());
+  bool process_event(Event const& event) { return process_event_from<0>(event); }
+
+  void flush() { flush_from<0>(); }
+
+  // every stage must accept
+  [[nodiscard]] constexpr LogLevel min_level() const {
+    return std::apply(
+        [](auto const&... stage) { return std::max({LogLevel::INHERIT, stage.min_level()...}); },
+        elts);
   }
 
   bool process_context(Metadata const& meta, bool entered, bool handover) {
@@ -109,6 +139,30 @@ struct All {
   auto operator>>(this T&& rhs, All<Us...> lhs) {
     return rsl::logging::All(std::forward<T>(rhs), lhs);
   }
+
+private:
+  template <std::size_t Idx>
+  void flush_from() {
+    if constexpr (Idx < sizeof...(Ts)) {
+      if constexpr (_impl::flushing_stage<Ts...[Idx]>) {
+        get<Idx>(elts).flush(
+            [this](Event const& next) { return process_event_from<Idx + 1>(next); });
+      }
+      flush_from<Idx + 1>();
+    }
+  }
+
+  template <std::size_t Idx>
+  bool process_event_from(Event const& event) {
+    if constexpr (Idx == sizeof...(Ts)) {
+      return true;
+    } else if constexpr (_impl::continuation_stage<Ts...[Idx]>) {
+      return get<Idx>(elts).process_event(
+          event, [this](Event const& next) { return process_event_from<Idx + 1>(next); });
+    } else {
+      return get<Idx>(elts).process_event(event) && process_event_from<Idx + 1>(event);
+    }
+  }
 };
 
 template <typename... Ts>
@@ -134,6 +188,25 @@ struct Any : Filter {
     }(std::index_sequence_for<Ts...>());
   }
 
+  // any stage may accept
+  [[nodiscard]] constexpr LogLevel min_level() const {
+    return std::apply(
+        [](auto const&... stage) { return std::min({LogLevel::DISABLE, stage.min_level()...}); },
+        elts);
+  }
+
+  void flush() {
+    std::apply(
+        [](auto&... branch) {
+          ([&] {
+            if constexpr (_impl::is_pipeline<std::remove_cvref_t<decltype(branch)>>) {
+              branch.flush();
+            }
+          }(), ...);
+        },
+        elts);
+  }
+
   bool process_context(Metadata const& meta, bool entered, bool handover) {
     return [&]<std::size_t... Idx>(std::index_sequence<Idx...>) {
       return (get<Idx>(elts).process_context(meta, entered, handover) || ...);
@@ -144,6 +217,21 @@ struct Any : Filter {
 template <typename... Ts>
 Any(Ts&&...) -> Any<Ts...>;
 
+// Accepts events of at least `level`. Unlike an equivalent predicate, it lets the output reject
+// lower severities up front.
+struct LevelFilter : Filter {
+  LogLevel level;
+
+  constexpr explicit LevelFilter(LogLevel level) : level(level) {}
+
+  [[nodiscard]] constexpr bool check(Metadata const& meta) const { return meta.severity >= level; }
+  [[nodiscard]] constexpr LogLevel min_level() const { return level; }
+};
+
+constexpr LevelFilter at_least(LogLevel level) {
+  return LevelFilter(level);
+}
+
 template <typename F>
 struct FilterFnc : Filter {
   F fnc;
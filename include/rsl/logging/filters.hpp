@@ -0,0 +1,176 @@
+#pragma once
+#include "clock.hpp"
+#include "filter.hpp"
+
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Filters that bound the volume of events, ie. `rate_limit(1000) >> TerminalSink()`.
+//
+// They only ever drop events, contexts are always let through so sinks see balanced
+// enter/exit pairs. Copies share their state, the same filter can be used in several outputs.
+// Checking an event never takes a lock. Suppressed events are counted per thread, so even a
+// callsite that is suppressed at full speed on every core does not bounce a shared counter.
+
+namespace rsl::logging {
+namespace _impl {
+// Generic cell rate algorithm on a fixed table of per-key buckets. Keys are claimed on first
+// use, if the table is crowded all remaining keys share an overflow bucket.
+class RateLimiter {
+  struct State;
+  std::shared_ptr<State> state;
+
+public:
+  RateLimiter(std::uint64_t count, std::chrono::nanoseconds period, std::uint64_t burst);
+
+  // `now` in nanoseconds on any monotonic scale
+  bool admit(std::uint64_t key, std::int64_t now) const;
+  [[nodiscard]] std::uint64_t suppressed() const;
+};
+}  // namespace _impl
+
+// Lets through up to `count` events per `period` for every callsite. Bursts of up to `burst`
+// events are admitted at once, it defaults to `count`. Time is taken from the steady clock when
+// checking, not from the event timestamp - a step of the wall clock neither suppresses a
+// callsite nor grants it an extra burst.
+struct RateLimit : Filter {
+  RateLimit(std::uint64_t count, std::chrono::nanoseconds period, std::uint64_t burst)
+      : limiter(count, period, burst) {}
+
+  bool check(Metadata const& meta) const {
+    return limiter.admit(reinterpret_cast<std::uintptr_t>(meta.callsite), _impl::steady_ns());
+  }
+
+  bool process_context(Metadata const&, bool, bool) const { return true; }
+
+  [[nodiscard]] std::uint64_t suppressed() const { return limiter.suppressed(); }
+
+private:
+  _impl::RateLimiter limiter;
+};
+
+// Like RateLimit, but with one budget per value of `key(meta)`, ie. per context name or per
+// value of a field. The key is hashed, distinct values may rarely share a budget.
+template <typename F>
+  requires std::invocable<F const&, Metadata const&>
+struct KeyedRateLimit : Filter {
+  template <typename U>
+  KeyedRateLimit(U&& key,
+                 std::uint64_t count,
+                 std::chrono::nanoseconds period,
+                 std::uint64_t burst)
+      : key(std::forward<U>(key))
+      , limiter(count, period, burst) {}
+
+  bool check(Metadata const& meta) const {
+    using key_type = std::remove_cvref_t<std::invoke_result_t<F const&, Metadata const&>>;
+    auto const hash = std::hash<key_type>{}(std::invoke(key, meta));
+    return limiter.admit(hash, _impl::steady_ns());
+  }
+
+  bool process_context(Metadata const&, bool, bool) const { return true; }
+
+  [[nodiscard]] std::uint64_t suppressed() const { return limiter.suppressed(); }
+
+private:
+  F key;
+  _impl::RateLimiter limiter;
+};
+
+// Lets through one in `n` events on average. Decisions are drawn from a per-thread generator,
+// there is no shared state besides the suppression count.
+struct Sample : Filter {
+  explicit Sample(std::uint64_t n);
+
+  bool check(Metadata const&) const;
+  bool process_context(Metadata const&, bool, bool) const { return true; }
+
+  [[nodiscard]] std::uint64_t suppressed() const;
+
+private:
+  struct State;
+  std::shared_ptr<State> state;
+};
+
+// Collapses runs of identical events, ie. from a retry loop. Events are identical if they come
+// from the same callsite and context and render to the same message. The first event of a run
+// is forwarded, repeats within `window` of it are dropped. Once the run ends - a different
+// event or a repeat after the window - a summary event with the number of dropped repeats is
+// sent before the event that ended it.
+//
+// Runs are tracked per thread, so checking an event touches only thread-local state. A run
+// whose thread stops logging is summarized by `flush()` once its window passed, call it
+// periodically or before shutdown, ie. through `Output::flush()`.
+struct Dedup : Filter {
+  explicit Dedup(std::chrono::nanoseconds window);
+
+  template <typename F>
+  bool process_event(Event const& event, F&& next) {
+    auto verdict = observe(event);
+    if (verdict.summary.has_value()) {
+      (void)next(*verdict.summary);
+    }
+    return verdict.forward && next(event);
+  }
+
+  // without a downstream stage there is no one to summarize to
+  bool process_event(Event const& event) {
+    return process_event(event, [](Event const&) { return true; });
+  }
+
+  bool process_context(Metadata const&, bool, bool) const { return true; }
+
+  // sends the summaries of runs of every thread whose window passed
+  template <typename F>
+  void flush(F&& next) {
+    for (auto const& summary : expired()) {
+      (void)next(summary);
+    }
+  }
+
+  [[nodiscard]] std::uint64_t suppressed() const;
+
+private:
+  struct Verdict {
+    bool forward;
+    std::optional<Event> summary;
+  };
+  Verdict observe(Event const& event);
+  std::vector<Event> expired() const;
+
+  struct State;
+  std::shared_ptr<State> state;
+};
+
+inline RateLimit rate_limit(std::uint64_t count,
+                            std::chrono::nanoseconds period = std::chrono::seconds(1),
+                            std::uint64_t burst             = 0) {
+  return {count, period, burst == 0 ? count : burst};
+}
+
+template <typename F>
+auto rate_limit_by(F&& key,
+                   std::uint64_t count,
+                   std::chrono::nanoseconds period = std::chrono::seconds(1),
+                   std::uint64_t burst             = 0) {
+  return KeyedRateLimit<std::decay_t<F>>(std::forward<F>(key),
+                                         count,
+                                         period,
+                                         burst == 0 ? count : burst);
+}
+
+inline Sample sample(std::uint64_t n) {
+  return Sample(n);
+}
+
+inline Dedup dedup(std::chrono::nanoseconds window = std::chrono::seconds(10)) {
+  return Dedup(window);
+}
+}  // namespace rsl::logging
@@ -1,35 +1,82 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <thread>
+
 #include "default.hpp"
+#include <rsl/logging/_impl/deferred.hpp>
 
 namespace rsl::logging {
+// Formats on the calling thread, then hands the event to a backend thread which owns all
+// interaction with the current output. Every producer thread pushes into its own bounded
+// SPSC queue; the backend merges those queues in timestamp order.
+//
+// Select it with
+//   template <>
+//   constexpr inline auto rsl::logging::selected_logger<> = rsl::logging::AsyncLogger();
+//
+// Outputs installed with `set_output` must outlive the backend or be detached after calling
+// `AsyncLogger::flush()`.
 struct AsyncLogger : DefaultLogger {
-  // message queue
+  constexpr static std::size_t queue_capacity = 1024;
+
+  struct Message {
+    enum class Kind : std::uint8_t { EVENT, ENTER, EXIT };
+    Kind kind;
+    bool async_handover = false;
+    Metadata meta;
+    std::optional<format_result> text;
+    _impl::DeferredMessage deferred;
+  };
 
-  void context(Metadata const& meta, bool entered, bool async_handover) {
-    // serialize
-    // submit to message queue
+  static void context(Metadata const& meta, bool entered, bool async_handover) {
+    submit(Message{.kind           = entered ? Message::Kind::ENTER : Message::Kind::EXIT,
+                   .async_handover = async_handover,
+                   .meta           = pin(meta)});
   }
 
   template <LogLevel Severity, typename... Args>
-  void emit(Metadata& meta, _impl::FormatString<Severity, Args...> fmt, Args&&... args) {
-    auto formatter = fmt.make_message;
-    // serialize formatter
-    // serialize metadata
-    // serialize arguments
-    // submit to message queue
+  static void emit(Metadata& meta, _impl::FormatString<Severity, Args...> fmt, Args&&... args) {
+    submit(Message{.kind = Message::Kind::EVENT,
+                   .meta = pin(meta),
+                   .text = fmt.make_message(std::forward<Args>(args)...)});
+
+    if constexpr (Severity >= LogLevel::FATAL) {
+      // the process is likely about to go down - don't return before the event is out
+      flush();
+    }
   }
 
-  // entrypoint for logging thread
-  static void process_messages() {
-    // pop from queue
-    // TODO handle context changes
+  // blocks until every message submitted before this call has been handed to the output
+  static void flush();
 
-    // deserialize formatter + arguments
-    // format
-    //   auto event = Event{/*TODO*/};
+protected:
+  struct Backend;
+
+  static Metadata pin(Metadata const& meta) {
+    auto pinned = meta;
+    pinned.pin();
+    return pinned;
+  }
+
+  static void submit(Message&& message);
+};
+
+// Like AsyncLogger, but the calling thread only captures the arguments. Formatting happens on
+// the backend thread. Arguments are moved or copied into the message record, pointers and
+// views are rejected at compile time since they may dangle by the time they are formatted.
+// This includes `char const*`, string literals are fine.
+struct DeferredLogger : AsyncLogger {
+  template <LogLevel Severity, typename... Args>
+  static void emit(Metadata& meta, _impl::FormatString<Severity, Args...> fmt, Args&&... args) {
+    submit(Message{.kind     = Message::Kind::EVENT,
+                   .meta     = pin(meta),
+                   .deferred = _impl::DeferredMessage(fmt.make_message, std::forward<Args>(args)...)});
 
-    //   if (auto* logger = current_output()) {
-    //     logger->emit(event);
-    //   }
+    if constexpr (Severity >= LogLevel::FATAL) {
+      flush();
+    }
   }
 };
-}  // namespace rsl::logging
\ No newline at end of file
+}  // namespace rsl::logging
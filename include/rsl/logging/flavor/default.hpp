@@ -1,4 +1,6 @@
 #pragma once
+#include <atomic>
+
 #include <rsl/logging/event.hpp>
 #include <rsl/logging/output.hpp>
 
@@ -17,19 +19,35 @@ struct DefaultLogger {
 
   template <LogLevel Severity, typename... Args>
   static void emit(Metadata& meta, _impl::FormatString<Severity, Args...> fmt, Args&&... args) {
-    auto message = fmt.make_message(std::forward<Args>(args)...);
-    auto event   = Event{.meta = meta, .text = message};
     if (auto* output = current_output()) {
-      output->emit(event);
+      // formatted only once a sink asks for the text
+      auto render = [&] { return fmt.make_message(std::forward<Args>(args)...); };
+      output->emit(Event::deferred(meta, render));
     }
   }
 
   static void set_output(OutputBase& output) {
     current_output() = &output;
+    output_level.store(output.min_level(), std::memory_order_relaxed);
+    handover_events.store(output.wants_handover(), std::memory_order_relaxed);
+  }
+
+  // false if the current output certainly rejects events of `level`, a single relaxed load
+  [[nodiscard]] static bool accepts(LogLevel level) {
+    return level >= output_level.load(std::memory_order_relaxed);
+  }
+
+  // false if no sink of the current output records coroutine handovers
+  [[nodiscard]] static bool wants_handover() {
+    return handover_events.load(std::memory_order_relaxed);
   }
 
-private:
+protected:
   static OutputBase*& current_output();
+  // constant initialized to match the default output, which accepts everything and does not
+  // record handovers
+  static inline std::atomic<LogLevel> output_level{LogLevel::INHERIT};
+  static inline std::atomic<bool> handover_events{false};
 };
 
 }  // namespace rsl::logging
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "level.hpp"
+
+namespace rsl::logging {
+struct Overrides {
+  std::optional<LogLevel> min_level;
+};
+
+// Trie of `::`-separated scope names carrying runtime overrides. Lookups fall back to the
+// closest parent with a value set. Nodes are never removed, pointers returned by
+// `add_overrides` stay valid for the lifetime of the root.
+struct Namespace {
+  std::string name;
+  Namespace* parent = nullptr;
+  Overrides overrides;
+  std::map<std::string, std::unique_ptr<Namespace>, std::less<>> children;
+
+  Namespace() = default;
+  Namespace(std::string name, Namespace* parent) : name(std::move(name)), parent(parent) {}
+
+  Namespace(Namespace const&)            = delete;
+  Namespace& operator=(Namespace const&) = delete;
+
+  // sets every override in `overrides` that has a value, an empty path refers to this node
+  Namespace* add_overrides(std::string_view path, Overrides const& overrides);
+
+  // `*` matches exactly one segment, `**` matches any number of segments including none
+  void remove_overrides(std::string_view pattern);
+
+  // nullopt if `path` is malformed, ie. contains empty segments
+  [[nodiscard]] std::optional<Overrides> get_overrides_for(std::string_view path) const;
+
+  [[nodiscard]] std::string full_name() const;
+};
+
+// The global hierarchy consulted by every callsite. Callsites cache their effective level,
+// changing the overrides invalidates all caches, see callsite.hpp.
+Namespace* add_overrides(std::string_view path, Overrides const& overrides);
+void remove_overrides(std::string_view pattern);
+[[nodiscard]] std::optional<Overrides> get_overrides_for(std::string_view path);
+}  // namespace rsl::logging
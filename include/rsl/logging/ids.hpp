@@ -0,0 +1,57 @@
+#pragma once
+#include <compare>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Span and trace IDs
+//
+// IDs are drawn from a per-thread PRNG seeded once per thread, generating one does not touch
+// any shared state. Span IDs are 64 bit and trace IDs 128 bit, matching the W3C trace context
+// format so they can be exchanged with other tracing systems through `traceparent` headers.
+// Zero is never generated, it marks an absent ID.
+
+namespace rsl::logging {
+namespace _impl {
+// next value of this thread's generator, never zero
+std::uint64_t random_id();
+}  // namespace _impl
+
+// writes the 16 lowercase hex digits of span ID `id` to `out`. Sinks emitting JSON use this rather
+// than a number, consumers parsing numbers as doubles would mangle random 64 bit IDs.
+void write_span_id(char* out, std::uint64_t id);
+
+struct TraceId {
+  std::uint64_t high = 0;
+  std::uint64_t low  = 0;
+
+  [[nodiscard]] static TraceId generate() { return {_impl::random_id(), _impl::random_id()}; }
+
+  [[nodiscard]] bool is_valid() const { return high != 0 || low != 0; }
+  friend auto operator<=>(TraceId const&, TraceId const&) = default;
+
+  // writes 32 lowercase hex digits to `out`
+  void write(char* out) const;
+};
+
+// Parsed W3C `traceparent` value: `00-<32 hex trace id>-<16 hex parent id>-<2 hex flags>`
+struct TraceParent {
+  static constexpr std::uint8_t sampled = 0x01;
+
+  TraceId trace_id;
+  std::uint64_t parent_id = 0;
+  std::uint8_t flags      = sampled;
+
+  // length of the version 00 encoding
+  static constexpr std::size_t size = 55;
+
+  // nullopt unless `value` is well-formed and both IDs are valid. Versions other than 00 are
+  // accepted as long as their prefix matches the 00 layout, as the specification requires.
+  [[nodiscard]] static std::optional<TraceParent> parse(std::string_view value);
+
+  // writes exactly `size` characters to `out`
+  void write(char* out) const;
+  [[nodiscard]] std::string to_string() const;
+};
+}  // namespace rsl::logging
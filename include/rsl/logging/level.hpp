@@ -38,6 +38,15 @@ consteval LogLevel parse_min_level(T value) {
   throw "unrecognized min level type";
 }
 
+constexpr std::string_view level_name(LogLevel level) {
+  template for (constexpr auto enumerator : std::define_static_array(enumerators_of(^^LogLevel))) {
+    if (level == [:enumerator:]) {
+      return identifier_of(enumerator);
+    }
+  }
+  return "UNKNOWN";
+}
+
 consteval LogLevel min_level_for(std::meta::info ctx) {
   while (ctx != ^^::) {
     if (meta::has_annotation(ctx, ^^LogLevel)) {
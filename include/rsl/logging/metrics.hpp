@@ -0,0 +1,254 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "level.hpp"
+
+// Self-metrics
+//
+// Every Output counts, per sink and severity, the events that reached the sink (accepted) and
+// those rejected by the filters in front of it (filtered). Time spent in a sink's `emit_event`
+// goes into a log-linear latency histogram. Sinks add the bytes they produced and the events
+// they lost through `report_bytes` and `report_dropped`.
+//
+// Counting costs a thread-local lookup and a few uncontended stores per sink call. Timing reads
+// the steady clock twice, which is as much as a cheap sink costs, so by default only one in 64
+// calls of a thread is timed. `set_latency_sampling` changes the rate, the histogram holds
+// samples while the counters are exact.
+//
+// Counts live in per-thread shards only their own thread writes to, there are no shared writes
+// on the hot path. `metrics_snapshot` sums all shards, counts of exited threads are retained.
+// Snapshots are not atomic with respect to concurrent events.
+//
+// RSL_LOG_METRICS=0 (CMake option `METRICS`) compiles all of it out of the hot path.
+
+#ifndef RSL_LOG_METRICS
+#  define RSL_LOG_METRICS 1
+#endif
+
+namespace rsl::logging {
+// 4 buckets per power of two from 16ns to ~17s. Faster emits share the first bucket, slower
+// ones the last.
+struct LatencyHistogram {
+  static constexpr unsigned sub_bucket_bits = 2;
+  static constexpr unsigned min_exponent    = 4;
+  static constexpr unsigned max_exponent    = 34;
+  static constexpr std::size_t bucket_count =
+      ((max_exponent - min_exponent) << sub_bucket_bits) + 2;
+
+  std::array<std::uint64_t, bucket_count> counts{};
+  std::uint64_t sum_ns = 0;
+
+  [[nodiscard]] static constexpr std::size_t bucket_for(std::uint64_t ns) {
+    if (ns < (1ULL << min_exponent)) {
+      return 0;
+    }
+    auto const exponent = static_cast<unsigned>(std::bit_width(ns)) - 1;
+    if (exponent >= max_exponent) {
+      return bucket_count - 1;
+    }
+    auto const sub = (ns >> (exponent - sub_bucket_bits)) & ((1U << sub_bucket_bits) - 1);
+    return 1 + ((exponent - min_exponent) << sub_bucket_bits) + sub;
+  }
+
+  // largest value falling into `bucket`, the last bucket is unbounded
+  [[nodiscard]] static constexpr std::uint64_t upper_bound(std::size_t bucket) {
+    if (bucket == 0) {
+      return (1ULL << min_exponent) - 1;
+    }
+    auto const exponent = min_exponent + ((bucket - 1) >> sub_bucket_bits);
+    auto const sub      = (bucket - 1) & ((1U << sub_bucket_bits) - 1);
+    return (1ULL << exponent) + ((sub + 1) << (exponent - sub_bucket_bits)) - 1;
+  }
+
+  [[nodiscard]] std::uint64_t count() const {
+    std::uint64_t total = 0;
+    for (auto bucket : counts) {
+      total += bucket;
+    }
+    return total;
+  }
+};
+
+namespace _impl {
+// TRACE to FATAL
+constexpr inline std::size_t level_count = 6;
+
+constexpr std::size_t level_index(LogLevel level) {
+  auto const value = std::to_underlying(level);
+  return value < 20 ? 0 : value >= 60 ? level_count - 1 : value / 10 - 1;
+}
+
+constexpr LogLevel level_at(std::size_t index) {
+  return LogLevel((index + 1) * 10);
+}
+}  // namespace _impl
+
+struct SinkMetrics {
+  struct Counters {
+    std::uint64_t accepted = 0;
+    std::uint64_t filtered = 0;
+    std::uint64_t bytes    = 0;
+    std::uint64_t dropped  = 0;
+  };
+
+  // type of the sink, ie. "TerminalSink", and a process-wide unique id
+  std::string name;
+  std::uint64_t id = 0;
+  std::array<Counters, _impl::level_count> levels{};
+  LatencyHistogram latency;
+
+  [[nodiscard]] Counters const& at(LogLevel level) const {
+    return levels[_impl::level_index(level)];
+  }
+
+  [[nodiscard]] Counters total() const {
+    Counters sum;
+    for (auto const& level : levels) {
+      sum.accepted += level.accepted;
+      sum.filtered += level.filtered;
+      sum.bytes += level.bytes;
+      sum.dropped += level.dropped;
+    }
+    return sum;
+  }
+};
+
+// one entry per sink of every live Output
+std::vector<SinkMetrics> metrics_snapshot();
+
+// Prometheus text exposition format
+std::string to_prometheus(std::span<SinkMetrics const> snapshot);
+
+// Times one in `period` sink calls of every thread, 1 times all of them and 0 none
+void set_latency_sampling(std::uint32_t period);
+
+namespace _impl {
+constexpr inline bool metrics_enabled = RSL_LOG_METRICS != 0;
+
+struct SinkShard {
+  struct Counters {
+    std::atomic<std::uint64_t> accepted{0};
+    std::atomic<std::uint64_t> filtered{0};
+    std::atomic<std::uint64_t> bytes{0};
+    std::atomic<std::uint64_t> dropped{0};
+  };
+
+  std::array<Counters, level_count> levels;
+  std::array<std::atomic<std::uint64_t>, LatencyHistogram::bucket_count> latency{};
+  std::atomic<std::uint64_t> latency_sum{0};
+  // registration the counts belong to, see SinkHandle
+  std::atomic<std::uint32_t> generation{0};
+
+  // only the owning thread writes, a plain load and store avoids a locked instruction
+  static void bump(std::atomic<std::uint64_t>& counter, std::uint64_t amount = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+  }
+};
+
+// Registers one sink of an Output. Registrations are recycled, a generation tells apart shards
+// still holding counts of a previous owner.
+class SinkHandle {
+  std::uint32_t slot       = UINT32_MAX;
+  std::uint32_t generation = 0;
+
+public:
+  explicit SinkHandle(std::string_view name);
+  ~SinkHandle();
+
+  SinkHandle(SinkHandle const&)            = delete;
+  SinkHandle& operator=(SinkHandle const&) = delete;
+
+  // this thread's shard, nullptr if the registry is full
+  [[nodiscard]] SinkShard* local() const;
+};
+
+// Installed while an Output runs one of its sinks, the sink reports through it
+struct Probe {
+  SinkShard* shard;
+  std::size_t level;
+  Probe* previous;
+  bool reached = false;
+
+  Probe(SinkHandle const& handle, LogLevel severity);
+  ~Probe();
+
+  Probe(Probe const&)            = delete;
+  Probe& operator=(Probe const&) = delete;
+
+  // Counts are per call of the sink, at the severity of the event it is called with. A filter
+  // may forward more than one event, ie. Dedup sends a summary ahead of the event ending a run.
+  void emitting(LogLevel severity) { level = level_index(severity); }
+
+  void emitted() {
+    reached = true;
+    SinkShard::bump(shard->levels[level].accepted);
+  }
+
+  void timed(std::chrono::nanoseconds elapsed) {
+    auto const ns = static_cast<std::uint64_t>(elapsed.count());
+    SinkShard::bump(shard->latency[LatencyHistogram::bucket_for(ns)]);
+    SinkShard::bump(shard->latency_sum, ns);
+  }
+};
+
+extern thread_local Probe* current_probe;
+
+extern std::atomic<std::uint32_t> latency_period;
+extern thread_local std::uint32_t latency_countdown;
+
+// whether to time the next sink call of this thread
+inline bool sample_latency() {
+  auto const period = latency_period.load(std::memory_order_relaxed);
+  if (period == 0) {
+    return false;
+  }
+  if (latency_countdown == 0 || latency_countdown >= period) {
+    latency_countdown = period - 1;
+    return true;
+  }
+  --latency_countdown;
+  return false;
+}
+
+inline Probe::Probe(SinkHandle const& handle, LogLevel severity)
+    : shard(handle.local())
+    , level(level_index(severity))
+    , previous(current_probe) {
+  current_probe = this;
+}
+
+inline Probe::~Probe() {
+  if (shard != nullptr && not reached) {
+    SinkShard::bump(shard->levels[level].filtered);
+  }
+  current_probe = previous;
+}
+}  // namespace _impl
+
+// For sinks, attributed to the event being emitted. Calls outside of `emit_event` are ignored.
+inline void report_bytes(std::size_t bytes) {
+  if constexpr (_impl::metrics_enabled) {
+    if (auto* probe = _impl::current_probe; probe != nullptr && probe->shard != nullptr) {
+      _impl::SinkShard::bump(probe->shard->levels[probe->level].bytes, bytes);
+    }
+  }
+}
+
+inline void report_dropped() {
+  if constexpr (_impl::metrics_enabled) {
+    if (auto* probe = _impl::current_probe; probe != nullptr && probe->shard != nullptr) {
+      _impl::SinkShard::bump(probe->shard->levels[probe->level].dropped);
+    }
+  }
+}
+}  // namespace rsl::logging
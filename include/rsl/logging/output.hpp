@@ -1,6 +1,13 @@
 #pragma once
+#include <array>
+#include <chrono>
+#include <meta>
+#include <string_view>
+#include <type_traits>
+
 #include <rsl/logging/event.hpp>
 #include <rsl/logging/filter.hpp>
+#include <rsl/logging/metrics.hpp>
 
 
 namespace rsl::logging {
@@ -14,6 +21,10 @@ struct Sink : Filter {
   // Optional:
   // void enter_context(Metadata const& meta, bool handover) {}
   // void exit_context(Metadata const& meta, bool handover) {}
+  //
+  // Sinks implementing either of them also receive the context events of coroutine handovers.
+  // Sinks with no use for those opt out, sparing the output their cost when no sink subscribes:
+  // constexpr static bool handover_events = false;
 
   template <typename T>
   bool process_context(this T&& self, Metadata const& meta, bool entered, bool async_handover) {
@@ -34,15 +45,76 @@ struct Sink : Filter {
     static_assert(
         requires { self.emit_event(event); },
         "Sink does not implement `void emit_event(Event)`");
+    if constexpr (_impl::metrics_enabled) {
+      if (auto* probe = _impl::current_probe; probe != nullptr && probe->shard != nullptr) {
+        probe->emitting(event.meta.severity);
+        if (_impl::sample_latency()) {
+          auto const start = std::chrono::steady_clock::now();
+          self.emit_event(event);
+          probe->timed(std::chrono::steady_clock::now() - start);
+        } else {
+          self.emit_event(event);
+        }
+        probe->emitted();
+        return false;
+      }
+    }
     self.emit_event(event);
     return false;
   }
 };
 
+namespace _impl {
+// the sink terminating a branch of an Output
+template <typename T>
+struct branch_sink {
+  using type = T;
+};
+
+template <typename... Ts>
+struct branch_sink<All<Ts...>> {
+  using type = typename branch_sink<Ts...[sizeof...(Ts) - 1]>::type;
+};
+
+// sinks subscribe if they handle context events and do not opt out, unknown branches are
+// assumed to subscribe
+template <typename T>
+consteval bool wants_handover() {
+  using S = typename branch_sink<std::remove_cvref_t<T>>::type;
+  if constexpr (requires { S::handover_events; }) {
+    return S::handover_events;
+  } else if constexpr (std::is_base_of_v<Sink, S>) {
+    return requires(S& sink, Metadata const& meta) { sink.enter_context(meta, true); } ||
+           requires(S& sink, Metadata const& meta) { sink.exit_context(meta, true); };
+  } else {
+    return true;
+  }
+}
+
+template <typename T>
+consteval std::string_view sink_name() {
+  constexpr auto type = dealias(^^typename branch_sink<std::remove_cvref_t<T>>::type);
+  if (has_template_arguments(type)) {
+    return std::define_static_string(identifier_of(template_of(type)));
+  } else if (has_identifier(type)) {
+    return std::define_static_string(identifier_of(type));
+  } else {
+    return "sink";
+  }
+}
+}  // namespace _impl
+
 struct OutputBase {
   virtual ~OutputBase()                                                         = default;
   virtual void context(Metadata const& meta, bool entered, bool async_handover) = 0;
   virtual void emit(Event const& ev)                                            = 0;
+
+  // lower bound on the severity of accepted events, see `Filter::min_level`
+  [[nodiscard]] virtual LogLevel min_level() const { return LogLevel::INHERIT; }
+  // whether any sink wants context events for coroutine handovers, see `Sink`
+  [[nodiscard]] virtual bool wants_handover() const { return true; }
+  // sends on events held back by filters, ie. summaries of Dedup runs that ended
+  virtual void flush() {}
 };
 
 template <typename... Ts>
@@ -57,16 +129,42 @@ struct Output final
     , Any<Ts...> {
   template <typename... Us>
     requires((std::same_as<std::remove_cvref_t<Us>, std::remove_cvref_t<Ts>> && ...))
-  explicit Output(Us&&... values) : Any<Ts...>(std::forward<Us>(values)...) {}
+  explicit Output(Us&&... values)
+      : Any<Ts...>(std::forward<Us>(values)...)
+      , metrics{_impl::SinkHandle(_impl::sink_name<Ts>())...} {}
 
   void context(Metadata const& meta, bool entered, bool async_handover) override {
     Any<Ts...>::process_context(meta, entered, async_handover);
   }
 
-  void emit(Event const& ev) override { Any<Ts...>::process_event(ev); }
+  void emit(Event const& ev) override {
+    if constexpr (_impl::metrics_enabled) {
+      // same short-circuiting as Any::process_event
+      [&]<std::size_t... Idx>(std::index_sequence<Idx...>) {
+        return (emit_metered<Idx>(ev) || ...);
+      }(std::index_sequence_for<Ts...>());
+    } else {
+      Any<Ts...>::process_event(ev);
+    }
+  }
+
+  [[nodiscard]] LogLevel min_level() const override { return Any<Ts...>::min_level(); }
+  void flush() override { Any<Ts...>::flush(); }
+  [[nodiscard]] bool wants_handover() const override {
+    return (_impl::wants_handover<Ts>() || ...);
+  }
 
   void set_as_default() && = delete;
   void set_as_default() & { set_output(*this); }
+
+private:
+  std::array<_impl::SinkHandle, sizeof...(Ts)> metrics;
+
+  template <std::size_t Idx>
+  bool emit_metered(Event const& ev) {
+    auto probe = _impl::Probe(metrics[Idx], ev.meta.severity);
+    return get<Idx>(this->elts).process_event(ev);
+  }
 };
 
 template <typename... Ts>
@@ -1,27 +1,158 @@
 #pragma once
 #include "output.hpp"
 
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
 #include <print>
 
 namespace rsl::logging {
+// Lines are formatted into a per-thread buffer which is written to stdout in a single call
+// once it holds 64 lines or 16 KiB, every 50ms, or right away for WARNING and above.
+// Severities are colored if stdout is a terminal.
 struct TerminalSink final : Sink {
+  // a line per handover would drown the output
+  constexpr static bool handover_events = false;
+
   void emit_event(Event const& event);
   void enter_context(Metadata const& meta, bool handover);
   void exit_context(Metadata const& meta, bool handover);
+
+  // writes out the buffers of all threads
+  static void flush();
 };
 using DefaultSink = TerminalSink;
 
+// Formats into an in-memory buffer which a background thread writes out. Producers never wait
+// for the file system, except for events at or above `flush_level` when `Durability::ON_FATAL`
+// requires the data to be on disk before returning.
 struct FileSink final : Sink {
+  constexpr static bool handover_events = false;
+
+  enum class Durability : std::uint8_t {
+    NONE,      // leave it to the kernel
+    PERIODIC,  // fdatasync every `sync_interval`
+    ON_FATAL,  // fdatasync before a FATAL event returns
+  };
+
+  struct Options {
+    std::filesystem::path path;
+
+    // flush once this many bytes are pending, after `max_age` or for events >= `flush_level`
+    std::size_t buffer_size = 1U << 20U;
+    std::chrono::milliseconds max_age{200};
+    LogLevel flush_level = LogLevel::ERROR;
+
+    // rotate to `path.1`, `path.2`, ... - zero disables the respective trigger
+    std::size_t max_file_size = 0;
+    std::chrono::seconds rotation_interval{0};
+    std::size_t max_files = 5;
+
+    Durability durability = Durability::NONE;
+    std::chrono::milliseconds sync_interval{1000};
+  };
+
+  struct Stats {
+    std::uint64_t writes    = 0;
+    std::uint64_t bytes     = 0;
+    std::uint64_t syncs     = 0;
+    std::uint64_t rotations = 0;
+  };
+
+  explicit FileSink(Options options);
+  explicit FileSink(std::filesystem::path path) : FileSink(Options{.path = std::move(path)}) {}
+
   void emit_event(Event const& event);
   void enter_context(Metadata const& meta, bool handover);
   void exit_context(Metadata const& meta, bool handover);
+
+  // blocks until everything emitted so far has been written
+  void flush();
+  [[nodiscard]] Stats stats() const;
+
+private:
+  struct State;
+  std::shared_ptr<State> state;
 };
 
-#if defined(__unix__) // && defined(RSL_LOG_SYSTEMD)
-struct SystemdSink final : Sink {
+// Writes length-prefixed binary records. Source locations, context and field names are stored
+// once per file in dictionary records. Use `rsl-log-decode` to turn the file into text or JSON.
+struct BinaryFileSink final : Sink {
+  explicit BinaryFileSink(std::filesystem::path const& path);
+
+  void emit_event(Event const& event);
+  void enter_context(Metadata const& meta, bool handover);
+  void exit_context(Metadata const& meta, bool handover);
+  void flush();
+
+private:
+  struct State;
+  std::shared_ptr<State> state;
+};
+
+// Writes one JSON object per line. Events carry the timestamp (unix nanoseconds), severity,
+// source location, message, arguments and the chain of enclosing contexts, innermost first.
+// Field values are encoded by their type, see `Field::to_json`.
+struct JsonLinesSink final : Sink {
+  // does not take ownership of `stream`
+  explicit JsonLinesSink(std::FILE* stream = stdout);
+  explicit JsonLinesSink(std::filesystem::path const& path);
+
   void emit_event(Event const& event);
   void enter_context(Metadata const& meta, bool handover);
   void exit_context(Metadata const& meta, bool handover);
+  void flush();
+
+private:
+  struct State;
+  std::shared_ptr<State> state;
+};
+
+// Keeps the most recent events of every thread in memory, to be written out when something goes
+// wrong. Each thread owns a ring of fixed-size records, recording an event renders its text into
+// the next slot without locks or allocation. Texts longer than a slot are truncated. All memory
+// is reserved up front, threads beyond `max_threads` are not recorded.
+//
+// The contents are dumped, oldest first, when a FATAL event is recorded, when `dump` is called
+// or when `signal` is delivered. Typically this sink sits next to a regular one which only
+// receives INFO and above.
+struct FlightRecorderSink final : Sink {
+  static constexpr std::size_t record_size = 256;
+
+  struct Options {
+    std::size_t records_per_thread = 1024;
+    std::size_t max_threads        = 32;
+
+    // dump target, stderr if empty
+    std::filesystem::path path;
+    bool dump_on_fatal = true;
+    // dump when this signal is delivered, ie. SIGUSR1. 0 disables
+    int signal = 0;
+  };
+
+  FlightRecorderSink() : FlightRecorderSink(Options{}) {}
+  explicit FlightRecorderSink(Options options);
+
+  void emit_event(Event const& event);
+
+  // writes all recorded events to the configured target, `output` or `stream`
+  void dump() const;
+  void dump(OutputBase& output) const;
+  void dump(std::FILE* stream) const;
+
+  // drops all recorded events
+  void clear();
+
+private:
+  struct State;
+  std::shared_ptr<State> state;
+};
+
+#if defined(__unix__) // && defined(RSL_LOG_SYSTEMD)
+struct SystemdSink final : Sink {
+  void emit_event(Event const& event);
 };
 #endif
 }  // namespace rsl::loggging
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <rsl/logging/flavor/async.hpp>
+#include <rsl/logging/_impl/ring.hpp>
+
+namespace rsl::logging {
+struct AsyncLogger::Backend {
+  struct Producer {
+    _impl::SpscRing<Message> queue{queue_capacity};
+    std::atomic<bool> closed{false};
+  };
+
+  // marks the producer as closed once its thread exits so the backend can drop it
+  struct LocalProducer {
+    std::shared_ptr<Producer> producer;
+
+    ~LocalProducer() {
+      if (producer) {
+        producer->closed.store(true, std::memory_order_release);
+      }
+    }
+  };
+
+  std::mutex mutex;
+  std::vector<std::shared_ptr<Producer>> producers;
+  std::atomic<std::size_t> generation{0};
+
+  std::atomic<bool> stopping{false};
+  std::atomic<bool> busy{false};
+  std::thread worker;
+
+  Backend() {
+    // make sure the default output is constructed before (and hence destroyed after) the backend
+    (void)current_output();
+    worker = std::thread([this] { run(); });
+  }
+
+  ~Backend() {
+    stopping.store(true, std::memory_order_release);
+    worker.join();
+  }
+
+  static Backend& instance() {
+    static Backend backend;
+    return backend;
+  }
+
+  static Producer& local() {
+    thread_local LocalProducer local{instance().add_producer()};
+    return *local.producer;
+  }
+
+  std::shared_ptr<Producer> add_producer() {
+    auto producer = std::make_shared<Producer>();
+    auto _        = std::lock_guard(mutex);
+    producers.push_back(producer);
+    generation.fetch_add(1, std::memory_order_release);
+    return producer;
+  }
+
+  void refresh(std::vector<std::shared_ptr<Producer>>& snapshot) {
+    auto _ = std::lock_guard(mutex);
+    std::erase_if(producers, [](auto const& producer) {
+      return producer->closed.load(std::memory_order_acquire) && producer->queue.empty();
+    });
+    snapshot = producers;
+  }
+
+  [[nodiscard]] bool idle() {
+    auto _ = std::lock_guard(mutex);
+    return std::ranges::all_of(producers, [](auto const& producer) {
+      return producer->queue.empty();
+    }) && not busy.load();
+  }
+
+  // Pops messages in timestamp order until all queues are empty. Messages from the same
+  // thread are never reordered since each queue is FIFO.
+  std::size_t drain(std::vector<std::shared_ptr<Producer>> const& snapshot) {
+    std::size_t dispatched = 0;
+    while (true) {
+      Producer* next  = nullptr;
+      Message* oldest = nullptr;
+      for (auto const& producer : snapshot) {
+        if (auto* message = producer->queue.front();
+            message != nullptr && (oldest == nullptr || message->meta.timestamp < oldest->meta.timestamp)) {
+          next   = producer.get();
+          oldest = message;
+        }
+      }
+
+      if (oldest == nullptr) {
+        return dispatched;
+      }
+
+      dispatch(*oldest);
+      next->queue.pop();
+      ++dispatched;
+    }
+  }
+
+  static void dispatch(Message& message) {
+    auto* output = current_output();
+    if (output == nullptr) {
+      return;
+    }
+
+    switch (message.kind) {
+      using enum Message::Kind;
+      case EVENT: {
+        if (message.text.has_value()) {
+          output->emit(Event(std::move(message.meta), std::move(*message.text)));
+        } else {
+          // DeferredLogger - records rejected by every filter are never formatted
+          auto render = [&] { return message.deferred.render(); };
+          output->emit(Event::deferred(std::move(message.meta), render));
+        }
+        break;
+      }
+      case ENTER: output->context(message.meta, true, message.async_handover); break;
+      case EXIT: output->context(message.meta, false, message.async_handover); break;
+    }
+  }
+
+  void run() {
+    std::vector<std::shared_ptr<Producer>> snapshot;
+    std::size_t seen = 0;
+    refresh(snapshot);
+
+    while (true) {
+      auto const stop_requested = stopping.load(std::memory_order_acquire);
+      if (auto current = generation.load(std::memory_order_acquire); current != seen) {
+        seen = current;
+        refresh(snapshot);
+      }
+
+      busy.store(true);
+      auto const dispatched = drain(snapshot);
+      busy.store(false);
+
+      if (dispatched == 0) {
+        if (stop_requested) {
+          break;
+        }
+        // queues of exited threads are dropped once drained, without waiting for a new producer
+        if (std::ranges::any_of(snapshot, [](auto const& producer) {
+              return producer->closed.load(std::memory_order_acquire);
+            })) {
+          refresh(snapshot);
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+      }
+    }
+  }
+};
+
+void AsyncLogger::submit(Message&& message) {
+  auto& producer = Backend::local();
+  while (not producer.queue.try_emplace(std::move(message))) {
+    // queue is full - apply backpressure rather than dropping
+    std::this_thread::yield();
+  }
+}
+
+void AsyncLogger::flush() {
+  auto& backend = Backend::instance();
+  while (not backend.idle()) {
+    std::this_thread::yield();
+  }
+}
+}  // namespace rsl::logging
@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include <rsl/logging/callsite.hpp>
+#include <rsl/logging/hierarchy.hpp>
+
+namespace rsl::logging {
+namespace {
+struct Registry {
+  std::atomic<std::uint64_t> generation{0};
+  std::atomic<Callsite*> head{nullptr};
+
+  static Registry& instance() {
+    static Registry registry;
+    return registry;
+  }
+
+  void add(Callsite* callsite) {
+    auto* current = head.load(std::memory_order_relaxed);
+    do {
+      callsite->next = current;
+    } while (not head.compare_exchange_weak(current,
+                                            callsite,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed));
+  }
+};
+}  // namespace
+
+bool Callsite::resolve() {
+  auto& registry = Registry::instance();
+  if (not registered.exchange(true, std::memory_order_acq_rel)) {
+    registry.add(this);
+  }
+
+  while (true) {
+    auto const generation = registry.generation.load();
+
+    auto effective = static_level;
+    if (not enabled.load(std::memory_order_relaxed)) {
+      effective = LogLevel::DISABLE;
+    } else if (auto overrides = get_overrides_for(scope);
+               overrides.has_value() && overrides->min_level.has_value()) {
+      effective = std::max(effective, *overrides->min_level);
+    }
+
+    // 0 means unresolved, CONTEXT is below every event level and lets everything pass
+    threshold.store(std::max(std::to_underlying(effective), std::to_underlying(LogLevel::CONTEXT)),
+                    std::memory_order_relaxed);
+
+    // something changed while we were resolving - the invalidation may have happened before
+    // our store, so try again
+    if (registry.generation.load() == generation) {
+      return level >= effective;
+    }
+  }
+}
+
+void Callsite::set_enabled(bool value) {
+  enabled.store(value, std::memory_order_relaxed);
+  Registry::instance().generation.fetch_add(1);
+  threshold.store(0, std::memory_order_relaxed);
+}
+
+std::vector<Callsite*> callsites() {
+  std::vector<Callsite*> result;
+  for (auto* callsite = Registry::instance().head.load(std::memory_order_acquire);
+       callsite != nullptr;
+       callsite = callsite->next) {
+    result.push_back(callsite);
+  }
+  return result;
+}
+
+namespace _impl {
+void invalidate_callsites() {
+  auto& registry = Registry::instance();
+  registry.generation.fetch_add(1);
+  for (auto* callsite = registry.head.load(std::memory_order_acquire); callsite != nullptr;
+       callsite       = callsite->next) {
+    callsite->threshold.store(0, std::memory_order_relaxed);
+  }
+}
+}  // namespace _impl
+}  // namespace rsl::logging
@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+#include <rsl/logging/clock.hpp>
+
+namespace rsl::logging::_impl {
+namespace {
+constexpr unsigned fraction_bits = 32;
+
+std::int64_t wall_clock_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+struct Anchor {
+  std::int64_t ticks;
+  std::int64_t unix_ns;
+};
+
+// reads both clocks back to back, retrying if we were preempted in between
+Anchor sample() {
+  Anchor best{};
+  std::int64_t best_gap = -1;
+  for (int attempt = 0; attempt < 5; ++attempt) {
+    auto before = read_ticks();
+    auto ns     = wall_clock_ns();
+    auto after  = read_ticks();
+    if (best_gap < 0 || after - before < best_gap) {
+      best_gap = after - before;
+      best     = {before + (after - before) / 2, ns};
+    }
+  }
+  return best;
+}
+
+// Conversion is `unix_ns = base_ns + ((ticks - base_ticks) * scale >> fraction_bits)`.
+// The three values are published under a seqlock: readers never block and only retry if a
+// recalibration happened concurrently, which is rare.
+class Calibration {
+public:
+  struct Snapshot {
+    std::int64_t base_ticks;
+    std::int64_t base_ns;
+    std::uint64_t scale;
+
+    [[nodiscard]] std::int64_t to_unix_ns(std::int64_t ticks) const {
+      auto delta = static_cast<__int128>(ticks - base_ticks) * static_cast<__int128>(scale);
+      return base_ns + static_cast<std::int64_t>(delta >> fraction_bits);
+    }
+  };
+
+private:
+  std::atomic<std::uint64_t> sequence{0};
+  std::atomic<std::int64_t> base_ticks{0};
+  std::atomic<std::int64_t> base_ns{0};
+  std::atomic<std::uint64_t> scale{0};
+
+  Anchor origin;
+  // the background thread's next wait, the horizon for correcting the rate
+  std::chrono::milliseconds interval{100};
+  std::mutex mutex;
+  std::condition_variable_any wake;
+  std::jthread worker;
+
+  void publish(Anchor anchor, std::uint64_t new_scale) {
+    auto seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    base_ticks.store(anchor.ticks, std::memory_order_relaxed);
+    base_ns.store(anchor.unix_ns, std::memory_order_relaxed);
+    scale.store(new_scale, std::memory_order_relaxed);
+    sequence.store(seq + 2, std::memory_order_release);
+  }
+
+  static std::uint64_t scale_between(Anchor from, Anchor to) {
+    auto ticks = to.ticks - from.ticks;
+    if (ticks <= 0) {
+      return std::uint64_t{1} << fraction_bits;
+    }
+    auto ns = static_cast<unsigned __int128>(to.unix_ns - from.unix_ns) << fraction_bits;
+    return static_cast<std::uint64_t>(ns / static_cast<unsigned __int128>(ticks));
+  }
+
+  // Follows the wall clock without ever converting a later tick to an earlier time. The new
+  // anchor continues the published conversion at `now`. If that is behind the wall clock it
+  // steps forward, if it is ahead the rate drops (by at most half) until the next
+  // recalibration makes up the difference.
+  void refresh(Anchor now) {
+    auto const rate      = scale_between(origin, now);
+    auto const converted = load().to_unix_ns(now.ticks);
+    if (converted <= now.unix_ns) {
+      publish(now, rate);
+      return;
+    }
+    auto const horizon = std::chrono::nanoseconds(interval).count();
+    auto const ahead   = std::min(converted - now.unix_ns, horizon / 2);
+    publish({now.ticks, converted},
+            static_cast<std::uint64_t>(static_cast<unsigned __int128>(rate) *
+                                       static_cast<unsigned __int128>(horizon - ahead) /
+                                       static_cast<unsigned __int128>(horizon)));
+  }
+
+  void run(std::stop_token stop) {
+    auto lock = std::unique_lock(mutex);
+    while (true) {
+      wake.wait_for(lock, stop, interval, [] { return false; });
+      if (stop.stop_requested()) {
+        break;
+      }
+      refresh(sample());
+      // refine quickly at first, the longer the baseline the more accurate the rate
+      interval = std::min<std::chrono::milliseconds>(interval * 4, std::chrono::seconds(10));
+    }
+  }
+
+public:
+  Calibration() : origin(sample()) {
+    // rough initial estimate, replaced by the background thread within 100ms
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(2);
+    while (std::chrono::steady_clock::now() < deadline) {
+    }
+    auto now = sample();
+    publish(now, scale_between(origin, now));
+    worker = std::jthread([this](std::stop_token stop) { run(std::move(stop)); });
+  }
+
+  Calibration(Calibration const&)            = delete;
+  Calibration& operator=(Calibration const&) = delete;
+
+  ~Calibration() {
+    worker.request_stop();
+    worker.join();
+  }
+
+  void recalibrate() {
+    auto _ = std::lock_guard(mutex);
+    refresh(sample());
+  }
+
+  Snapshot load() const {
+    while (true) {
+      auto seq = sequence.load(std::memory_order_acquire);
+      if ((seq & 1U) != 0) {
+        continue;
+      }
+      auto snapshot = Snapshot{base_ticks.load(std::memory_order_relaxed),
+                               base_ns.load(std::memory_order_relaxed),
+                               scale.load(std::memory_order_relaxed)};
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence.load(std::memory_order_relaxed) == seq) {
+        return snapshot;
+      }
+    }
+  }
+};
+
+Calibration& calibration() {
+  static Calibration instance;
+  return instance;
+}
+}  // namespace
+
+std::int64_t ticks_to_unix_ns(std::int64_t ticks) {
+  return calibration().load().to_unix_ns(ticks);
+}
+
+std::int64_t unix_ns_to_ticks(std::int64_t unix_ns) {
+  auto [base_ticks, base_ns, scale] = calibration().load();
+  if (scale == 0) {
+    return base_ticks;
+  }
+  auto delta = static_cast<__int128>(unix_ns - base_ns) << fraction_bits;
+  return base_ticks + static_cast<std::int64_t>(delta / static_cast<__int128>(scale));
+}
+
+void recalibrate_clock() {
+  calibration().recalibrate();
+}
+}  // namespace rsl::logging::_impl
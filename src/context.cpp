@@ -7,39 +7,165 @@
 #include <rsl/logging/output.hpp>
 
 namespace rsl::logging {
+namespace _impl {
+// starts at 1 so default-constructed caches are stale
+std::atomic<std::uint64_t> context_epoch{1};
+}  // namespace _impl
+
 thread_local Context* current_context = Context::get_default();
 
+namespace {
+// its address identifies the current thread
+thread_local char const thread_token = 0;
+// owner of contexts handed over by a suspended coroutine
+char const detached_token = 0;
+
+std::atomic<std::uint64_t> foreign_exit_count{0};
+
+void report_foreign_exit(Context const& context) {
+  if (foreign_exit_count.fetch_add(1, std::memory_order_relaxed) == 0) {
+    std::println(stderr,
+                 "rsl::log: context `{}` ({}) exited on a thread it is not active on",
+                 context.name,
+                 context.id);
+  }
+}
+}  // namespace
+
 void Context::activate() {
   assert(parent == nullptr);
-  parent          = current_context;
+  parent = current_context;
+  owner  = &thread_token;
+  if (parent->owner == &thread_token) {
+    parent->child = this;
+  }
+  if (not trace_id.is_valid()) {
+    trace_id    = parent->trace_id.is_valid() ? parent->trace_id : TraceId::generate();
+    trace_flags = parent->trace_id.is_valid() ? parent->trace_flags : trace_flags;
+  }
   current_context = this;
+  (void)refresh_level(_impl::context_epoch.load(std::memory_order_acquire));
 }
 
 bool Context::deactivate() {
-  if (current_context && current_context->id == id) {
-    // fast path - we were are in the current context
-    current_context = current_context->parent;
-    parent          = nullptr;
+  if (owner == &detached_token) {
+    // exited while handed over, ie. its coroutine is destroyed while suspended. The detached
+    // segment is not on any stack, unlinking it from its neighbours is all there is to do.
+    if (child != nullptr) {
+      child->parent = parent;
+    }
+    if (parent != nullptr && parent->owner == &detached_token) {
+      parent->child = child;
+    }
+    parent = nullptr;
+    child  = nullptr;
+    owner  = nullptr;
     return true;
   }
 
-  for (Context* current = current_context; current != nullptr && current->parent; current = current->parent) {
-    if (current->parent->id == id) {
-      current->parent = current->parent->parent;
-      parent          = nullptr;
-      return true;
+  if (owner != &thread_token) {
+    report_foreign_exit(*this);
+    return false;
+  }
+
+  if (child != nullptr) {
+    // somewhere in the middle, contexts above may have inherited our level
+    child->parent = parent;
+    refresh_inherited(child);
+  } else {
+    current_context = parent;
+  }
+
+  if (parent != nullptr && parent->owner == &thread_token) {
+    parent->child = child;
+  }
+
+  parent = nullptr;
+  child  = nullptr;
+  owner  = nullptr;
+  return true;
+}
+
+Context* Context::detach_above(Context const* base) {
+  auto* top = current_context;
+  if (top == base) {
+    return nullptr;
+  }
+
+  // find the segment first, nothing changes if `base` is not below
+  Context* bottom = nullptr;
+  for (auto* context = top; context != nullptr && context->owner == &thread_token;
+       context       = context->parent) {
+    if (context->parent == base) {
+      bottom = context;
+      break;
     }
   }
+  if (bottom == nullptr) {
+    return nullptr;
+  }
 
-  return false;
+  current_context = bottom->parent;
+  if (current_context->owner == &thread_token) {
+    current_context->child = nullptr;
+  }
+  bottom->parent = nullptr;
+  for (auto* context = top; context != nullptr; context = context->parent) {
+    context->owner = &detached_token;
+  }
+  return top;
 }
 
-bool Context::enabled_for(LogLevel level) const {
-  if (min_level == LogLevel::INHERIT) {
-    return parent != nullptr && parent->enabled_for(level);
-  } else {
-    return level >= min_level;
+void Context::attach(Context* top) {
+  Context* bottom = top;
+  for (auto* context = top; context != nullptr; context = context->parent) {
+    context->owner = &thread_token;
+    bottom         = context;
   }
+
+  bottom->parent = current_context;
+  if (current_context->owner == &thread_token) {
+    current_context->child = bottom;
+  }
+  current_context = top;
+  // the new parent may filter differently
+  refresh_inherited(bottom);
+}
+
+void Context::refresh_inherited(Context* from) {
+  // Only this thread's cached levels can depend on the relinked parent. Bumping the global
+  // epoch instead would invalidate every context on every thread.
+  auto const epoch = _impl::context_epoch.load(std::memory_order_acquire);
+  for (auto* context = from; context != nullptr; context = context->child) {
+    (void)context->refresh_level(epoch);
+    if (std::atomic_ref(context->min_level).load(std::memory_order_relaxed) != LogLevel::INHERIT) {
+      // contexts further out inherit from this one, which does not depend on its parent
+      break;
+    }
+  }
+}
+
+std::uint64_t Context::foreign_exits() {
+  return foreign_exit_count.load(std::memory_order_relaxed);
+}
+
+LogLevel Context::refresh_level(std::uint64_t epoch) const {
+  // `set_min_level` may run concurrently, ie. on the shared default context
+  auto level = std::atomic_ref(const_cast<LogLevel&>(min_level)).load(std::memory_order_relaxed);
+  if (level == LogLevel::INHERIT) {
+    if (parent != nullptr) {
+      level = parent->effective_level();
+    } else if (auto const* fallback = get_default(); fallback != this) {
+      level = fallback->effective_level();
+    }
+  }
+  cached_level.value.store(_impl::CachedLevel::pack(epoch, level), std::memory_order_relaxed);
+  return level;
+}
+
+void Context::set_min_level(LogLevel level) {
+  std::atomic_ref(min_level).store(level, std::memory_order_relaxed);
+  _impl::context_epoch.fetch_add(1, std::memory_order_release);
 }
 
 Context* Context::get_default() {
@@ -48,8 +174,7 @@ Context* Context::get_default() {
   return &default_span;
 }
 
-std::size_t Context::next_id() {
-  static std::atomic_unsigned_lock_free counter{1};
-  return counter.fetch_add(1);
+std::uint64_t Context::next_id() {
+  return _impl::random_id();
 }
 }  // namespace rsl::logging
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+#include <unistd.h>
+
+#include <rsl/logging/context.hpp>
+#include <rsl/logging/crash.hpp>
+
+namespace rsl::logging {
+namespace {
+constexpr std::array fatal_signals = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+
+struct Hook {
+  std::atomic<CrashHook> function{nullptr};
+  std::atomic<void*> data{nullptr};
+};
+std::array<Hook, 32> hooks;
+// serializes registration only, the handler never takes it
+std::mutex hooks_mutex;
+
+std::atomic<int> crash_fd{-1};
+std::atomic<bool> installed{false};
+// set by the first thread to crash, which reports and sets `reported` once its hooks returned
+std::atomic<bool> crashing{false};
+std::atomic<bool> reported{false};
+std::atomic<pid_t> reporter{0};
+
+// upper bound for a later crash to wait on the report, hooks give up on their own after a second
+constexpr int report_wait_ms = 5'000;
+
+std::array<struct sigaction, fatal_signals.size()> previous_actions{};
+std::terminate_handler previous_terminate = nullptr;
+
+// preallocated, a crash may well be a stack overflow
+constexpr std::size_t alt_stack_size = 64U << 10U;
+std::unique_ptr<char[]> alt_stack;
+
+std::string_view signal_name(int signal) {
+  switch (signal) {
+    case SIGSEGV: return "SIGSEGV";
+    case SIGBUS: return "SIGBUS";
+    case SIGFPE: return "SIGFPE";
+    case SIGILL: return "SIGILL";
+    case SIGABRT: return "SIGABRT";
+    default: return "signal";
+  }
+}
+
+// the final line: cause and the contexts active on this thread, innermost first
+void report(std::string_view cause) {
+  static _impl::SignalSafeBuffer<4096> line;
+  line.clear();
+  line << "FATAL crashed with " << cause;
+  for (auto const* context = current_context; context != nullptr; context = context->parent) {
+    line << (context == current_context ? " in " : " <- ") << std::string_view(context->name)
+         << " (" << std::uint64_t(context->id) << ")";
+  }
+  line << "\n";
+
+  if (auto const fd = crash_fd.load(std::memory_order_relaxed); fd >= 0) {
+    _impl::write_all(fd, line.view());
+  }
+  for (auto& hook : hooks) {
+    if (auto* function = hook.function.load(std::memory_order_acquire)) {
+      function(hook.data.load(std::memory_order_relaxed), line.view());
+    }
+  }
+}
+
+// Reports if this is the first crash. A later crash on another thread must not take the default
+// action while the report is still running, that would kill the process halfway through the
+// hooks' flush, so it waits for the report for a bounded time. A crash within the report itself
+// goes on at once, waiting for itself would only delay the inevitable.
+void report_once(std::string_view cause) {
+  if (not crashing.exchange(true)) {
+    reporter.store(::gettid(), std::memory_order_relaxed);
+    report(cause);
+    reported.store(true, std::memory_order_release);
+    return;
+  }
+  if (reporter.load(std::memory_order_relaxed) == ::gettid()) {
+    return;
+  }
+  constexpr timespec pause{0, 1'000'000};
+  for (int waited = 0; waited < report_wait_ms && not reported.load(std::memory_order_acquire);
+       ++waited) {
+    ::nanosleep(&pause, nullptr);
+  }
+}
+
+void restore_default(int signal) {
+  struct sigaction action{};
+  action.sa_handler = SIG_DFL;
+  sigemptyset(&action.sa_mask);
+  ::sigaction(signal, &action, nullptr);
+}
+
+extern "C" void on_fatal_signal(int signal, siginfo_t*, void*) {
+  report_once(signal_name(signal));
+  restore_default(signal);
+  ::raise(signal);
+}
+
+[[noreturn]] void on_terminate() {
+  report_once("std::terminate");
+  // SIGABRT now goes straight to the default action
+  restore_default(SIGABRT);
+  std::abort();
+}
+}  // namespace
+
+namespace _impl {
+void write_all(int fd, std::string_view data) {
+  while (not data.empty()) {
+    auto const result = ::write(fd, data.data(), data.size());
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    data.remove_prefix(static_cast<std::size_t>(result));
+  }
+}
+}  // namespace _impl
+
+bool register_crash_hook(CrashHook hook, void* data) {
+  auto _ = std::lock_guard(hooks_mutex);
+  for (auto& slot : hooks) {
+    // publish `data` before the function, the handler reads them in the opposite order
+    if (slot.function.load(std::memory_order_relaxed) == nullptr) {
+      slot.data.store(data, std::memory_order_relaxed);
+      slot.function.store(hook, std::memory_order_release);
+      return true;
+    }
+  }
+  return false;
+}
+
+void unregister_crash_hook(CrashHook hook, void* data) {
+  auto _ = std::lock_guard(hooks_mutex);
+  for (auto& slot : hooks) {
+    if (slot.function.load(std::memory_order_relaxed) == hook &&
+        slot.data.load(std::memory_order_relaxed) == data) {
+      slot.function.store(nullptr, std::memory_order_release);
+      return;
+    }
+  }
+}
+
+void install_crash_handler(int fd) {
+  crash_fd.store(fd, std::memory_order_relaxed);
+  if (installed.exchange(true)) {
+    return;
+  }
+
+  // only covers the installing thread, other threads overflowing their stack die silently
+  alt_stack = std::make_unique<char[]>(alt_stack_size);
+  stack_t stack{};
+  stack.ss_sp    = alt_stack.get();
+  stack.ss_size  = alt_stack_size;
+  stack.ss_flags = 0;
+  ::sigaltstack(&stack, nullptr);
+
+  struct sigaction action{};
+  action.sa_sigaction = on_fatal_signal;
+  action.sa_flags     = SA_SIGINFO | SA_ONSTACK;
+  sigemptyset(&action.sa_mask);
+  for (std::size_t idx = 0; idx < fatal_signals.size(); ++idx) {
+    ::sigaction(fatal_signals[idx], &action, &previous_actions[idx]);
+  }
+  previous_terminate = std::set_terminate(on_terminate);
+}
+
+void uninstall_crash_handler() {
+  if (not installed.exchange(false)) {
+    return;
+  }
+  for (std::size_t idx = 0; idx < fatal_signals.size(); ++idx) {
+    ::sigaction(fatal_signals[idx], &previous_actions[idx], nullptr);
+  }
+  std::set_terminate(previous_terminate);
+}
+}  // namespace rsl::logging
@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <rsl/logging/filters.hpp>
+#include <rsl/logging/ids.hpp>
+
+namespace rsl::logging {
+namespace {
+constexpr std::size_t cache_line = 64;
+
+// Counter split across cache lines, each thread increments its own shard. Reading sums all
+// shards and is not a snapshot.
+class ShardedCounter {
+  static constexpr std::size_t shard_count = 32;
+
+  struct alignas(cache_line) Shard {
+    std::atomic<std::uint64_t> value{0};
+  };
+  std::array<Shard, shard_count> shards;
+
+  static std::size_t shard_index() {
+    static std::atomic<std::size_t> next_thread{0};
+    thread_local std::size_t const index =
+        next_thread.fetch_add(1, std::memory_order_relaxed) % shard_count;
+    return index;
+  }
+
+public:
+  void increment() { shards[shard_index()].value.fetch_add(1, std::memory_order_relaxed); }
+
+  [[nodiscard]] std::uint64_t load() const {
+    std::uint64_t total = 0;
+    for (auto const& shard : shards) {
+      total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+};
+}  // namespace
+
+namespace _impl {
+struct RateLimiter::State {
+  static constexpr std::size_t bucket_count = 1024;
+  static constexpr std::size_t max_probes   = 16;
+
+  // `tat` is the theoretical arrival time of the next event, an event arriving at `now` is
+  // admitted if `tat - now` does not exceed the burst tolerance
+  struct alignas(cache_line) Bucket {
+    std::atomic<std::uint64_t> key{0};
+    std::atomic<std::int64_t> tat{0};
+  };
+
+  std::int64_t interval;
+  std::int64_t tolerance;
+  std::array<Bucket, bucket_count> buckets;
+  Bucket overflow;
+  ShardedCounter suppressed;
+
+  State(std::uint64_t count, std::chrono::nanoseconds period, std::uint64_t burst)
+      : interval(std::max<std::int64_t>(1, period.count() / std::max<std::int64_t>(count, 1)))
+      , tolerance(interval * (std::max<std::int64_t>(burst, 1) - 1)) {}
+
+  Bucket& find(std::uint64_t key) {
+    // 0 marks a free bucket
+    key = key == 0 ? 1 : key;
+    // keys are often pointers, mix the bits before using them as an index
+    auto const hash = (key * 0x9E37'79B9'7F4A'7C15ULL) >> 54U;
+    for (std::size_t probe = 0; probe < max_probes; ++probe) {
+      auto& bucket  = buckets[(hash + probe) % bucket_count];
+      auto existing = bucket.key.load(std::memory_order_acquire);
+      if (existing == key) {
+        return bucket;
+      }
+      if (existing == 0 &&
+          (bucket.key.compare_exchange_strong(existing, key, std::memory_order_acq_rel) ||
+           existing == key)) {
+        return bucket;
+      }
+    }
+    return overflow;
+  }
+};
+
+RateLimiter::RateLimiter(std::uint64_t count, std::chrono::nanoseconds period, std::uint64_t burst)
+    : state(std::make_shared<State>(count, period, burst)) {}
+
+bool RateLimiter::admit(std::uint64_t key, std::int64_t now) const {
+  auto& bucket = state->find(key);
+  auto tat     = bucket.tat.load(std::memory_order_relaxed);
+  while (true) {
+    auto const start = std::max(tat, now);
+    if (start - now > state->tolerance) {
+      // rejecting never writes to the bucket
+      state->suppressed.increment();
+      return false;
+    }
+    if (bucket.tat.compare_exchange_weak(tat, start + state->interval, std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+}
+
+std::uint64_t RateLimiter::suppressed() const {
+  return state->suppressed.load();
+}
+}  // namespace _impl
+
+struct Sample::State {
+  std::uint64_t n;
+  ShardedCounter suppressed;
+
+  explicit State(std::uint64_t n) : n(std::max<std::uint64_t>(n, 1)) {}
+};
+
+Sample::Sample(std::uint64_t n) : state(std::make_shared<State>(n)) {}
+
+bool Sample::check(Metadata const&) const {
+  if (state->n == 1 || _impl::random_id() % state->n == 0) {
+    return true;
+  }
+  state->suppressed.increment();
+  return false;
+}
+
+std::uint64_t Sample::suppressed() const {
+  return state->suppressed.load();
+}
+
+struct Dedup::State : std::enable_shared_from_this<State> {
+  std::int64_t window;
+  std::size_t index;
+  ShardedCounter suppressed;
+
+  // The current run of one thread. Only `flush()` touches it from another thread, the lock is
+  // uncontended otherwise.
+  struct Run {
+    std::mutex mutex;
+    std::size_t key       = 0;
+    std::int64_t start    = 0;
+    std::uint64_t repeats = 0;
+    // a pinned copy of the first repeat, the summary is sent in its name
+    std::optional<Metadata> last;
+
+    // summary of the dropped repeats, if any
+    std::optional<Event> end() {
+      if (repeats == 0) {
+        return std::nullopt;
+      }
+      auto summary = std::optional<Event>(
+          std::in_place,
+          *last,
+          ::rsl::format("last message repeated {} time{}", repeats, repeats == 1 ? "" : "s"));
+      repeats = 0;
+      last.reset();
+      return summary;
+    }
+  };
+
+  // one run per thread that used the filter, they live as long as the filter
+  std::mutex runs_mutex;
+  std::deque<Run> runs;
+
+  explicit State(std::chrono::nanoseconds window)
+      : window(window.count())
+      , index(next_index.fetch_add(1, std::memory_order_relaxed)) {}
+
+  Run& local_run() {
+    // indices are never reused, a slot matching ours points into our `runs`
+    struct Slot {
+      std::size_t index;
+      std::weak_ptr<State> owner;
+      Run* run;
+    };
+    thread_local std::vector<Slot> slots;
+    for (auto const& slot : slots) {
+      if (slot.index == index) {
+        return *slot.run;
+      }
+    }
+
+    std::erase_if(slots, [](Slot const& slot) { return slot.owner.expired(); });
+    auto lock = std::lock_guard(runs_mutex);
+    auto& run = runs.emplace_back();
+    slots.push_back({.index = index, .owner = weak_from_this(), .run = &run});
+    return run;
+  }
+
+  static inline std::atomic<std::size_t> next_index{0};
+};
+
+Dedup::Dedup(std::chrono::nanoseconds window) : state(std::make_shared<State>(window)) {}
+
+Dedup::Verdict Dedup::observe(Event const& event) {
+  auto const& meta = event.meta;
+  auto const now   = _impl::steady_ns();
+  auto key         = std::hash<std::string_view>{}(event.text());
+  key ^= std::hash<void const*>{}(meta.callsite) + 0x9E37'79B9'7F4A'7C15ULL + (key << 6U);
+  key ^= std::hash<std::uint64_t>{}(meta.context->id) + 0x9E37'79B9'7F4A'7C15ULL + (key << 6U);
+
+  auto& run = state->local_run();
+  auto lock = std::lock_guard(run.mutex);
+  if (run.key == key && now - run.start < state->window) {
+    if (run.repeats++ == 0) {
+      run.last = meta;
+      run.last->pin();
+    }
+    run.last->timestamp = meta.timestamp;
+    state->suppressed.increment();
+    return {.forward = false, .summary = std::nullopt};
+  }
+
+  Verdict verdict{.forward = true, .summary = run.end()};
+  run.key   = key;
+  run.start = now;
+  return verdict;
+}
+
+std::vector<Event> Dedup::expired() const {
+  auto const now = _impl::steady_ns();
+  std::vector<Event> summaries;
+  auto lock = std::lock_guard(state->runs_mutex);
+  for (auto& run : state->runs) {
+    auto run_lock = std::lock_guard(run.mutex);
+    if (now - run.start < state->window) {
+      continue;
+    }
+    if (auto summary = run.end()) {
+      summaries.push_back(std::move(*summary));
+    }
+  }
+  return summaries;
+}
+
+std::uint64_t Dedup::suppressed() const {
+  return state->suppressed.load();
+}
+}  // namespace rsl::logging
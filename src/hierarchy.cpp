@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <rsl/logging/callsite.hpp>
+#include <rsl/logging/hierarchy.hpp>
+
+namespace rsl::logging {
+namespace {
+// splits `foo::bar` into segments, returns false for empty segments such as in `foo::::bar`
+bool split(std::string_view path, std::vector<std::string_view>& segments) {
+  segments.clear();
+  if (path.empty()) {
+    return true;
+  }
+
+  while (true) {
+    auto separator = path.find("::");
+    auto segment   = path.substr(0, separator);
+    if (segment.empty()) {
+      return false;
+    }
+    segments.push_back(segment);
+    if (separator == std::string_view::npos) {
+      return true;
+    }
+    path.remove_prefix(separator + 2);
+  }
+}
+
+void remove_matching(Namespace& node, std::span<std::string_view const> pattern) {
+  if (pattern.empty()) {
+    node.overrides = {};
+    return;
+  }
+
+  auto const head = pattern.front();
+  auto const rest = pattern.subspan(1);
+  if (head == "**") {
+    remove_matching(node, rest);
+    for (auto& [_, child] : node.children) {
+      remove_matching(*child, pattern);
+    }
+  } else if (head == "*") {
+    for (auto& [_, child] : node.children) {
+      remove_matching(*child, rest);
+    }
+  } else if (auto it = node.children.find(head); it != node.children.end()) {
+    remove_matching(*it->second, rest);
+  }
+}
+
+struct Global {
+  std::shared_mutex mutex;
+  Namespace root;
+
+  static Global& instance() {
+    static Global global;
+    return global;
+  }
+};
+}  // namespace
+
+Namespace* Namespace::add_overrides(std::string_view path, Overrides const& values) {
+  std::vector<std::string_view> segments;
+  if (not split(path, segments)) {
+    return nullptr;
+  }
+
+  Namespace* node = this;
+  for (auto segment : segments) {
+    auto it = node->children.find(segment);
+    if (it == node->children.end()) {
+      auto child = std::make_unique<Namespace>(std::string(segment), node);
+      it         = node->children.emplace(std::string(segment), std::move(child)).first;
+    }
+    node = it->second.get();
+  }
+
+  if (values.min_level.has_value()) {
+    node->overrides.min_level = values.min_level;
+  }
+  return node;
+}
+
+void Namespace::remove_overrides(std::string_view pattern) {
+  std::vector<std::string_view> segments;
+  if (split(pattern, segments)) {
+    remove_matching(*this, segments);
+  }
+}
+
+std::optional<Overrides> Namespace::get_overrides_for(std::string_view path) const {
+  std::vector<std::string_view> segments;
+  if (not split(path, segments)) {
+    return std::nullopt;
+  }
+
+  Overrides result      = overrides;
+  Namespace const* node = this;
+  for (auto segment : segments) {
+    auto it = node->children.find(segment);
+    if (it == node->children.end()) {
+      break;
+    }
+    node = it->second.get();
+    if (node->overrides.min_level.has_value()) {
+      result.min_level = node->overrides.min_level;
+    }
+  }
+  return result;
+}
+
+std::string Namespace::full_name() const {
+  if (parent == nullptr) {
+    return name;
+  }
+  auto prefix = parent->full_name();
+  return prefix.empty() ? name : prefix + "::" + name;
+}
+
+Namespace* add_overrides(std::string_view path, Overrides const& overrides) {
+  Namespace* node = nullptr;
+  {
+    auto& global = Global::instance();
+    auto _       = std::unique_lock(global.mutex);
+    node         = global.root.add_overrides(path, overrides);
+  }
+  _impl::invalidate_callsites();
+  return node;
+}
+
+void remove_overrides(std::string_view pattern) {
+  {
+    auto& global = Global::instance();
+    auto _       = std::unique_lock(global.mutex);
+    global.root.remove_overrides(pattern);
+  }
+  _impl::invalidate_callsites();
+}
+
+std::optional<Overrides> get_overrides_for(std::string_view path) {
+  auto& global = Global::instance();
+  auto _       = std::shared_lock(global.mutex);
+  return global.root.get_overrides_for(path);
+}
+}  // namespace rsl::logging
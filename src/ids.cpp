@@ -0,0 +1,139 @@
+#include <chrono>
+#include <random>
+#include <thread>
+
+#include <rsl/logging/ids.hpp>
+
+namespace rsl::logging {
+namespace {
+std::uint64_t splitmix64(std::uint64_t& state) {
+  auto z = (state += 0x9E37'79B9'7F4A'7C15ULL);
+  z      = (z ^ (z >> 30U)) * 0xBF58'476D'1CE4'E5B9ULL;
+  z      = (z ^ (z >> 27U)) * 0x94D0'49BB'1331'11EBULL;
+  return z ^ (z >> 31U);
+}
+
+// xoshiro256** - a few cycles per ID and no shared writes
+struct Generator {
+  std::uint64_t state[4];
+
+  Generator() {
+    // random_device alone may be deterministic on some platforms, mix in time and thread
+    std::uint64_t seed = (std::uint64_t(std::random_device{}()) << 32U) ^ std::random_device{}();
+    seed ^= std::uint64_t(std::chrono::steady_clock::now().time_since_epoch().count());
+    seed ^= std::hash<std::thread::id>{}(std::this_thread::get_id()) * 0x9E37'79B9'7F4A'7C15ULL;
+    for (auto& word : state) {
+      word = splitmix64(seed);
+    }
+  }
+
+  static std::uint64_t rotl(std::uint64_t value, int shift) {
+    return (value << shift) | (value >> (64 - shift));
+  }
+
+  std::uint64_t next() {
+    auto const result = rotl(state[1] * 5, 7) * 9;
+    auto const t      = state[1] << 17U;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 45);
+    return result;
+  }
+};
+
+constexpr char hex_digits[] = "0123456789abcdef";
+
+void write_hex(char* out, std::uint64_t value, int digits) {
+  for (int idx = digits - 1; idx >= 0; --idx) {
+    out[idx] = hex_digits[value & 0xFU];
+    value >>= 4U;
+  }
+}
+
+// lowercase only, as required by the specification
+bool parse_hex(std::string_view text, std::uint64_t& value) {
+  value = 0;
+  for (char c : text) {
+    std::uint64_t digit = 0;
+    if (c >= '0' && c <= '9') {
+      digit = std::uint64_t(c - '0');
+    } else if (c >= 'a' && c <= 'f') {
+      digit = std::uint64_t(c - 'a' + 10);
+    } else {
+      return false;
+    }
+    value = (value << 4U) | digit;
+  }
+  return true;
+}
+}  // namespace
+
+namespace _impl {
+std::uint64_t random_id() {
+  thread_local Generator generator;
+  std::uint64_t id = 0;
+  while (id == 0) {
+    id = generator.next();
+  }
+  return id;
+}
+}  // namespace _impl
+
+void write_span_id(char* out, std::uint64_t id) {
+  write_hex(out, id, 16);
+}
+
+void TraceId::write(char* out) const {
+  write_hex(out, high, 16);
+  write_hex(out + 16, low, 16);
+}
+
+std::optional<TraceParent> TraceParent::parse(std::string_view value) {
+  if (value.size() < size || value[2] != '-' || value[35] != '-' || value[52] != '-') {
+    return std::nullopt;
+  }
+
+  std::uint64_t version = 0;
+  if (not parse_hex(value.substr(0, 2), version) || version == 0xFF) {
+    return std::nullopt;
+  }
+  // version 00 has no trailing data, future versions may append `-<more>`
+  if (version == 0 ? value.size() != size : (value.size() > size && value[size] != '-')) {
+    return std::nullopt;
+  }
+
+  TraceParent result;
+  std::uint64_t flags = 0;
+  if (not parse_hex(value.substr(3, 16), result.trace_id.high) ||
+      not parse_hex(value.substr(19, 16), result.trace_id.low) ||
+      not parse_hex(value.substr(36, 16), result.parent_id) ||
+      not parse_hex(value.substr(53, 2), flags)) {
+    return std::nullopt;
+  }
+  if (not result.trace_id.is_valid() || result.parent_id == 0) {
+    return std::nullopt;
+  }
+  result.flags = static_cast<std::uint8_t>(flags);
+  return result;
+}
+
+void TraceParent::write(char* out) const {
+  out[0] = '0';
+  out[1] = '0';
+  out[2] = '-';
+  trace_id.write(out + 3);
+  out[35] = '-';
+  write_hex(out + 36, parent_id, 16);
+  out[52] = '-';
+  write_hex(out + 53, flags, 2);
+}
+
+std::string TraceParent::to_string() const {
+  std::string result(size, '\0');
+  write(result.data());
+  return result;
+}
+}  // namespace rsl::logging
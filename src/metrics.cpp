@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <format>
+#include <iterator>
+#include <mutex>
+
+#include <rsl/logging/metrics.hpp>
+
+namespace rsl::logging {
+namespace _impl {
+thread_local Probe* current_probe = nullptr;
+std::atomic<std::uint32_t> latency_period{64};
+thread_local std::uint32_t latency_countdown = 0;
+}  // namespace _impl
+
+namespace {
+constexpr std::size_t max_sinks = 256;
+
+struct Totals {
+  std::array<SinkMetrics::Counters, _impl::level_count> levels{};
+  LatencyHistogram latency;
+
+  void add(_impl::SinkShard const& shard) {
+    for (std::size_t idx = 0; idx < _impl::level_count; ++idx) {
+      levels[idx].accepted += shard.levels[idx].accepted.load(std::memory_order_relaxed);
+      levels[idx].filtered += shard.levels[idx].filtered.load(std::memory_order_relaxed);
+      levels[idx].bytes += shard.levels[idx].bytes.load(std::memory_order_relaxed);
+      levels[idx].dropped += shard.levels[idx].dropped.load(std::memory_order_relaxed);
+    }
+    for (std::size_t idx = 0; idx < LatencyHistogram::bucket_count; ++idx) {
+      latency.counts[idx] += shard.latency[idx].load(std::memory_order_relaxed);
+    }
+    latency.sum_ns += shard.latency_sum.load(std::memory_order_relaxed);
+  }
+};
+
+struct Slot {
+  std::string name;
+  std::uint64_t id = 0;
+  bool active      = false;
+  std::atomic<std::uint32_t> generation{0};
+  // counts of threads that exited while the sink was registered
+  Totals retired;
+};
+
+struct ThreadShards;
+
+struct Registry {
+  std::mutex mutex;
+  std::array<Slot, max_sinks> slots;
+  std::vector<ThreadShards*> threads;
+  std::uint64_t next_id = 0;
+
+  // never destroyed, threads may exit after static destructors ran
+  static Registry& instance() {
+    static auto* registry = new Registry();
+    return *registry;
+  }
+};
+
+struct ThreadShards {
+  std::array<std::atomic<_impl::SinkShard*>, max_sinks> shards{};
+
+  ThreadShards() {
+    auto& registry = Registry::instance();
+    auto _         = std::lock_guard(registry.mutex);
+    registry.threads.push_back(this);
+  }
+
+  ThreadShards(ThreadShards const&)            = delete;
+  ThreadShards& operator=(ThreadShards const&) = delete;
+
+  ~ThreadShards() {
+    auto& registry = Registry::instance();
+    auto _         = std::lock_guard(registry.mutex);
+    for (std::size_t idx = 0; idx < max_sinks; ++idx) {
+      auto* shard = shards[idx].load(std::memory_order_relaxed);
+      if (shard == nullptr) {
+        continue;
+      }
+      auto& slot = registry.slots[idx];
+      if (slot.active && shard->generation.load(std::memory_order_relaxed) ==
+                             slot.generation.load(std::memory_order_relaxed)) {
+        slot.retired.add(*shard);
+      }
+      delete shard;
+    }
+    std::erase(registry.threads, this);
+  }
+};
+
+void reset(_impl::SinkShard& shard) {
+  for (auto& level : shard.levels) {
+    level.accepted.store(0, std::memory_order_relaxed);
+    level.filtered.store(0, std::memory_order_relaxed);
+    level.bytes.store(0, std::memory_order_relaxed);
+    level.dropped.store(0, std::memory_order_relaxed);
+  }
+  for (auto& bucket : shard.latency) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  shard.latency_sum.store(0, std::memory_order_relaxed);
+}
+
+void write_labels(std::string& out, SinkMetrics const& sink) {
+  std::format_to(std::back_inserter(out), "sink=\"{}\",id=\"{}\"", sink.name, sink.id);
+}
+}  // namespace
+
+namespace _impl {
+SinkHandle::SinkHandle(std::string_view name) {
+  if constexpr (not metrics_enabled) {
+    return;
+  }
+  auto& registry = Registry::instance();
+  auto _         = std::lock_guard(registry.mutex);
+  for (std::uint32_t idx = 0; idx < max_sinks; ++idx) {
+    auto& candidate = registry.slots[idx];
+    if (candidate.active) {
+      continue;
+    }
+    candidate.active  = true;
+    candidate.name    = name;
+    candidate.id      = registry.next_id++;
+    candidate.retired = {};
+    // shards still tagged with the previous generation are reset on their next use
+    generation = candidate.generation.fetch_add(1, std::memory_order_relaxed) + 1;
+    slot       = idx;
+    return;
+  }
+}
+
+SinkHandle::~SinkHandle() {
+  if (slot == UINT32_MAX) {
+    return;
+  }
+  auto& registry = Registry::instance();
+  auto _         = std::lock_guard(registry.mutex);
+  registry.slots[slot].active = false;
+}
+
+SinkShard* SinkHandle::local() const {
+  if (slot == UINT32_MAX) {
+    return nullptr;
+  }
+  thread_local ThreadShards thread_shards;
+  auto& entry = thread_shards.shards[slot];
+  auto* shard = entry.load(std::memory_order_relaxed);
+  if (shard == nullptr) {
+    shard = new SinkShard();
+    entry.store(shard, std::memory_order_release);
+  }
+  if (shard->generation.load(std::memory_order_relaxed) != generation) {
+    reset(*shard);
+    shard->generation.store(generation, std::memory_order_release);
+  }
+  return shard;
+}
+}  // namespace _impl
+
+std::vector<SinkMetrics> metrics_snapshot() {
+  auto& registry = Registry::instance();
+  auto _         = std::lock_guard(registry.mutex);
+
+  std::vector<SinkMetrics> snapshot;
+  for (std::size_t idx = 0; idx < max_sinks; ++idx) {
+    auto const& slot = registry.slots[idx];
+    if (not slot.active) {
+      continue;
+    }
+    auto totals           = slot.retired;
+    auto const generation = slot.generation.load(std::memory_order_relaxed);
+    for (auto const* thread : registry.threads) {
+      auto const* shard = thread->shards[idx].load(std::memory_order_acquire);
+      if (shard != nullptr && shard->generation.load(std::memory_order_acquire) == generation) {
+        totals.add(*shard);
+      }
+    }
+    snapshot.push_back(
+        {.name = slot.name, .id = slot.id, .levels = totals.levels, .latency = totals.latency});
+  }
+  std::ranges::sort(snapshot, {}, &SinkMetrics::id);
+  return snapshot;
+}
+
+std::string to_prometheus(std::span<SinkMetrics const> snapshot) {
+  std::string out;
+  auto out_it = std::back_inserter(out);
+
+  auto counter = [&](std::string_view name,
+                     std::string_view help,
+                     std::uint64_t SinkMetrics::Counters::* member) {
+    std::format_to(out_it, "# HELP {} {}\n# TYPE {} counter\n", name, help, name);
+    for (auto const& sink : snapshot) {
+      for (std::size_t idx = 0; idx < _impl::level_count; ++idx) {
+        std::format_to(out_it, "{}{{", name);
+        write_labels(out, sink);
+        std::format_to(out_it,
+                       ",level=\"{}\"}} {}\n",
+                       level_name(_impl::level_at(idx)),
+                       sink.levels[idx].*member);
+      }
+    }
+  };
+
+  counter("rsl_log_events_accepted_total",
+          "Events that reached the sink.",
+          &SinkMetrics::Counters::accepted);
+  counter("rsl_log_events_filtered_total",
+          "Events rejected by the filters in front of the sink.",
+          &SinkMetrics::Counters::filtered);
+  counter("rsl_log_bytes_total", "Bytes produced by the sink.", &SinkMetrics::Counters::bytes);
+  counter("rsl_log_events_dropped_total",
+          "Events the sink accepted but lost.",
+          &SinkMetrics::Counters::dropped);
+
+  constexpr std::string_view histogram = "rsl_log_sink_emit_seconds";
+  std::format_to(out_it,
+                 "# HELP {} Time spent emitting an event.\n# TYPE {} histogram\n",
+                 histogram,
+                 histogram);
+  for (auto const& sink : snapshot) {
+    std::uint64_t cumulative = 0;
+    // the last bucket is unbounded, it only shows up as +Inf
+    for (std::size_t idx = 0; idx + 1 < LatencyHistogram::bucket_count; ++idx) {
+      cumulative += sink.latency.counts[idx];
+      std::format_to(out_it, "{}_bucket{{", histogram);
+      write_labels(out, sink);
+      std::format_to(out_it,
+                     ",le=\"{}\"}} {}\n",
+                     double(LatencyHistogram::upper_bound(idx)) / 1e9,
+                     cumulative);
+    }
+    auto const count = cumulative + sink.latency.counts.back();
+    std::format_to(out_it, "{}_bucket{{", histogram);
+    write_labels(out, sink);
+    std::format_to(out_it, ",le=\"+Inf\"}} {}\n", count);
+
+    std::format_to(out_it, "{}_sum{{", histogram);
+    write_labels(out, sink);
+    std::format_to(out_it, "}} {}\n", double(sink.latency.sum_ns) / 1e9);
+
+    std::format_to(out_it, "{}_count{{", histogram);
+    write_labels(out, sink);
+    std::format_to(out_it, "}} {}\n", count);
+  }
+  return out;
+}
+
+void set_latency_sampling(std::uint32_t period) {
+  _impl::latency_period.store(period, std::memory_order_relaxed);
+}
+}  // namespace rsl::logging
@@ -0,0 +1,196 @@
+#include <cerrno>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+
+#include <rsl/logging/sinks.hpp>
+#include <rsl/logging/_impl/binary_format.hpp>
+
+namespace rsl::logging {
+namespace binary = _impl::binary;
+
+namespace {
+struct StringHash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view value) const {
+    return std::hash<std::string_view>{}(value);
+  }
+};
+
+// source location strings have static storage, identify callsites by address
+struct CallsiteKey {
+  void const* file;
+  void const* function;
+  std::uint32_t line;
+
+  bool operator==(CallsiteKey const&) const = default;
+};
+
+struct CallsiteHash {
+  std::size_t operator()(CallsiteKey const& key) const {
+    auto hash = std::hash<void const*>{}(key.file);
+    hash ^= std::hash<void const*>{}(key.function) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+    return hash ^ (key.line + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2));
+  }
+};
+
+std::uint64_t to_integer(std::thread::id thread) {
+  return std::hash<std::thread::id>{}(thread);
+}
+}  // namespace
+
+struct BinaryFileSink::State {
+  std::mutex mutex;
+  std::FILE* file = nullptr;
+  std::string buffer;
+  std::unordered_map<std::string, std::uint32_t, StringHash, std::equal_to<>> strings;
+  std::unordered_map<CallsiteKey, std::uint32_t, CallsiteHash> callsites;
+
+  explicit State(std::filesystem::path const& path) : file(std::fopen(path.c_str(), "wb")) {
+    if (file == nullptr) {
+      throw std::system_error(errno, std::generic_category(), "could not open " + path.string());
+    }
+    std::setvbuf(file, nullptr, _IOFBF, 1U << 20U);
+
+    auto writer = binary::Writer{buffer};
+    buffer.append(binary::magic, sizeof(binary::magic));
+    writer.put(binary::version);
+    writer.put(binary::byte_order);
+    commit();
+  }
+
+  State(State const&)            = delete;
+  State& operator=(State const&) = delete;
+
+  ~State() { std::fclose(file); }
+
+  std::uint32_t intern(std::string_view value) {
+    if (auto it = strings.find(value); it != strings.end()) {
+      return it->second;
+    }
+
+    auto id = static_cast<std::uint32_t>(strings.size());
+    strings.emplace(std::string(value), id);
+
+    auto writer = binary::Writer{buffer};
+    auto record = writer.begin_record(binary::RecordKind::STRING);
+    writer.put(id);
+    writer.put(value);
+    writer.end_record(record);
+    return id;
+  }
+
+  void intern(ExtraFields const& fields) {
+    for (auto const& field : fields) {
+      intern(field.name);
+      intern(field.type_name());
+    }
+  }
+
+  std::uint32_t intern(rsl::source_location const& sloc) {
+    auto file_name = std::string_view(sloc.file);
+    auto function  = std::string_view(sloc.function);
+    auto key       = CallsiteKey{file_name.data(), function.data(), static_cast<std::uint32_t>(sloc.line)};
+    if (auto it = callsites.find(key); it != callsites.end()) {
+      return it->second;
+    }
+
+    auto file_id     = intern(file_name);
+    auto function_id = intern(function);
+    auto id          = static_cast<std::uint32_t>(callsites.size());
+    callsites.emplace(key, id);
+
+    auto writer = binary::Writer{buffer};
+    auto record = writer.begin_record(binary::RecordKind::CALLSITE);
+    writer.put(id);
+    writer.put(file_id);
+    writer.put(function_id);
+    writer.put(key.line);
+    writer.end_record(record);
+    return id;
+  }
+
+  // names must have been interned before starting the record
+  void put(binary::Writer& writer, ExtraFields const& fields) {
+    writer.put(static_cast<std::uint16_t>(std::ranges::distance(fields)));
+    for (auto const& field : fields) {
+      writer.put(intern(field.name));
+      writer.put(intern(field.type_name()));
+      writer.put(std::string_view(field.to_string()));
+    }
+  }
+
+  void write_context(Metadata const& meta, bool entered, bool handover) {
+    auto const& context = *meta.context;
+    auto _              = std::lock_guard(mutex);
+
+    auto callsite = intern(context.sloc);
+    auto name     = intern(context.name);
+    intern(context.arguments);
+    intern(context.extra);
+
+    auto writer = binary::Writer{buffer};
+    auto record = writer.begin_record(binary::RecordKind::CONTEXT);
+    writer.put(static_cast<std::uint8_t>(entered));
+    writer.put(static_cast<std::uint8_t>(handover));
+    writer.put(meta.timestamp.unix_ns());
+    writer.put(to_integer(meta.thread_id));
+    writer.put(static_cast<std::uint64_t>(context.id));
+    writer.put(name);
+    writer.put(callsite);
+    put(writer, context.arguments);
+    put(writer, context.extra);
+    writer.end_record(record);
+    commit();
+  }
+
+  void commit() {
+    std::fwrite(buffer.data(), 1, buffer.size(), file);
+    buffer.clear();
+  }
+};
+
+BinaryFileSink::BinaryFileSink(std::filesystem::path const& path)
+    : state(std::make_shared<State>(path)) {}
+
+void BinaryFileSink::emit_event(Event const& event) {
+  auto const& meta = event.meta;
+  auto _           = std::lock_guard(state->mutex);
+
+  auto callsite = state->intern(meta.sloc);
+  auto name     = state->intern(meta.context->name);
+  state->intern(*meta.arguments);
+  state->intern(meta.context->extra);
+
+  auto writer = binary::Writer{state->buffer};
+  auto record = writer.begin_record(binary::RecordKind::EVENT);
+  writer.put(callsite);
+  writer.put(static_cast<std::uint8_t>(meta.severity));
+  writer.put(meta.timestamp.unix_ns());
+  writer.put(to_integer(meta.thread_id));
+  writer.put(static_cast<std::uint64_t>(meta.context->id));
+  writer.put(name);
+  writer.put(event.text());
+  state->put(writer, *meta.arguments);
+  state->put(writer, meta.context->extra);
+  writer.end_record(record);
+  state->commit();
+}
+
+void BinaryFileSink::enter_context(Metadata const& meta, bool handover) {
+  state->write_context(meta, true, handover);
+}
+
+void BinaryFileSink::exit_context(Metadata const& meta, bool handover) {
+  state->write_context(meta, false, handover);
+}
+
+void BinaryFileSink::flush() {
+  auto _ = std::lock_guard(state->mutex);
+  std::fflush(state->file);
+}
+}  // namespace rsl::logging
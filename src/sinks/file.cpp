@@ -0,0 +1,313 @@
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <format>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <rsl/logging/crash.hpp>
+#include <rsl/logging/sinks.hpp>
+
+namespace rsl::logging {
+struct FileSink::State {
+  Options options;
+
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable written;
+
+  // guarded by `mutex`
+  std::string pending;
+  std::uint64_t appended  = 0;
+  std::uint64_t committed = 0;
+  std::uint64_t synced    = 0;
+  bool urgent             = false;
+  bool sync_requested     = false;
+  bool stopping           = false;
+
+  // owned by the writer thread
+  int fd                = -1;
+  std::size_t file_size = 0;
+  std::chrono::system_clock::time_point opened_at;
+  std::chrono::steady_clock::time_point last_sync;
+  std::string writing;
+
+  std::atomic<std::uint64_t> writes{0};
+  std::atomic<std::uint64_t> bytes{0};
+  std::atomic<std::uint64_t> syncs{0};
+  std::atomic<std::uint64_t> rotations{0};
+
+  std::thread writer;
+
+  explicit State(Options opts) : options(std::move(opts)) {
+    pending.reserve(options.buffer_size);
+    writing.reserve(options.buffer_size);
+    if (not open_file()) {
+      throw std::system_error(errno,
+                              std::generic_category(),
+                              "could not open " + options.path.string());
+    }
+    last_sync = std::chrono::steady_clock::now();
+    writer    = std::thread([this] { run(); });
+    register_crash_hook(&State::on_crash, this);
+  }
+
+  State(State const&)            = delete;
+  State& operator=(State const&) = delete;
+
+  ~State() {
+    unregister_crash_hook(&State::on_crash, this);
+    {
+      auto _   = std::lock_guard(mutex);
+      stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+
+  bool open_file() {
+    fd = ::open(options.path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat info{};
+    file_size = ::fstat(fd, &info) == 0 ? static_cast<std::size_t>(info.st_size) : 0;
+    opened_at = std::chrono::system_clock::now();
+    return true;
+  }
+
+  void sync() {
+    if (fd >= 0 && ::fdatasync(fd) == 0) {
+      syncs.fetch_add(1, std::memory_order_relaxed);
+    }
+    last_sync = std::chrono::steady_clock::now();
+  }
+
+  [[nodiscard]] bool should_rotate(std::size_t incoming) const {
+    if (options.max_file_size != 0 && file_size != 0 &&
+        file_size + incoming > options.max_file_size) {
+      return true;
+    }
+    return options.rotation_interval.count() != 0 &&
+           std::chrono::system_clock::now() - opened_at >= options.rotation_interval;
+  }
+
+  void rotate() {
+    if (fd >= 0) {
+      if (options.durability != Durability::NONE) {
+        sync();
+      }
+      ::close(fd);
+      fd = -1;
+    }
+
+    std::error_code ec;
+    auto rotated = [&](std::size_t idx) {
+      auto name = options.path;
+      name += "." + std::to_string(idx);
+      return name;
+    };
+
+    if (options.max_files == 0) {
+      std::filesystem::remove(options.path, ec);
+    } else {
+      // the oldest file gets overwritten by its successor
+      for (auto idx = options.max_files - 1; idx >= 1; --idx) {
+        std::filesystem::rename(rotated(idx), rotated(idx + 1), ec);
+      }
+      std::filesystem::rename(options.path, rotated(1), ec);
+    }
+
+    open_file();
+    rotations.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void write_out(std::string_view data) {
+    if (should_rotate(data.size())) {
+      rotate();
+    }
+
+    while (not data.empty() && fd >= 0) {
+      auto result = ::write(fd, data.data(), data.size());
+      if (result < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        break;
+      }
+      writes.fetch_add(1, std::memory_order_relaxed);
+      bytes.fetch_add(static_cast<std::uint64_t>(result), std::memory_order_relaxed);
+      file_size += static_cast<std::size_t>(result);
+      data.remove_prefix(static_cast<std::size_t>(result));
+    }
+  }
+
+  void run() {
+    auto lock = std::unique_lock(mutex);
+    while (true) {
+      wake.wait_for(lock, options.max_age, [&] { return urgent || stopping; });
+
+      std::swap(pending, writing);
+      auto const batch_end = appended;
+      auto const must_sync = std::exchange(sync_requested, false);
+      auto const stop      = stopping;
+      urgent               = false;
+      lock.unlock();
+
+      if (not writing.empty()) {
+        write_out(writing);
+        writing.clear();
+      }
+
+      bool durable = must_sync;
+      if (must_sync) {
+        sync();
+      } else if (options.durability == Durability::PERIODIC &&
+                 std::chrono::steady_clock::now() - last_sync >= options.sync_interval) {
+        sync();
+        durable = true;
+      }
+
+      lock.lock();
+      committed = batch_end;
+      if (durable) {
+        synced = batch_end;
+      }
+      written.notify_all();
+
+      if (stop && pending.empty()) {
+        break;
+      }
+    }
+  }
+
+  void append(std::string_view line, LogLevel severity) {
+    auto const wait_for_disk =
+        severity >= LogLevel::FATAL && options.durability == Durability::ON_FATAL;
+    auto lock = std::unique_lock(mutex);
+    pending += line;
+    appended += line.size();
+    auto const target = appended;
+
+    if (pending.size() < options.buffer_size && severity < options.flush_level &&
+        not wait_for_disk) {
+      return;
+    }
+
+    urgent = true;
+    sync_requested |= wait_for_disk;
+    lock.unlock();
+    wake.notify_one();
+
+    if (wait_for_disk) {
+      lock.lock();
+      written.wait(lock, [&] { return synced >= target || stopping; });
+    }
+  }
+
+  // Writes out `pending` directly. A batch the writer thread is working on is waited for, it
+  // holds older lines, for at most a second so a stuck writer cannot hang the crash handler.
+  // `mutex` is never released, the process is going down.
+  static void on_crash(void* data, std::string_view fatal_line) {
+    constexpr long crash_wait_ns = 1'000'000'000;
+    auto& state = *static_cast<State*>(data);
+
+    timespec start{};
+    ::clock_gettime(CLOCK_MONOTONIC, &start);
+    while (true) {
+      if (not _impl::try_lock_briefly(state.mutex)) {
+        return;
+      }
+      if (state.committed + state.pending.size() == state.appended) {
+        break;
+      }
+      state.mutex.unlock();
+
+      timespec now{};
+      ::clock_gettime(CLOCK_MONOTONIC, &now);
+      if ((now.tv_sec - start.tv_sec) * 1'000'000'000L + (now.tv_nsec - start.tv_nsec) >=
+          crash_wait_ns) {
+        return;
+      }
+      constexpr timespec pause{0, 1'000'000};
+      ::nanosleep(&pause, nullptr);
+    }
+    // the writer thread is idle now, `fd` is stable
+    _impl::write_all(state.fd, state.pending);
+    _impl::write_all(state.fd, fatal_line);
+    if (state.options.durability != Durability::NONE) {
+      ::fdatasync(state.fd);
+    }
+  }
+
+  void flush() {
+    auto lock         = std::unique_lock(mutex);
+    auto const target = appended;
+    urgent            = true;
+    wake.notify_one();
+    written.wait(lock, [&] { return committed >= target || stopping; });
+  }
+};
+
+namespace {
+std::string& scratch() {
+  thread_local std::string buffer;
+  buffer.clear();
+  return buffer;
+}
+}  // namespace
+
+FileSink::FileSink(Options options) : state(std::make_shared<State>(std::move(options))) {}
+
+void FileSink::emit_event(Event const& event) {
+  auto& line = scratch();
+  std::format_to(std::back_inserter(line),
+                 "{} ({: >8} {}) {}\n",
+                 event.meta.timestamp,
+                 event.meta.context->name,
+                 event.meta.context->id,
+                 event.text());
+  report_bytes(line.size());
+  state->append(line, event.meta.severity);
+}
+
+void FileSink::enter_context(Metadata const& meta, bool handover) {
+  auto& line = scratch();
+  std::format_to(std::back_inserter(line), "entered {}\n", meta.context->name);
+  for (auto const& extra : meta.context->arguments) {
+    std::format_to(std::back_inserter(line), "  {} = {}\n", extra.name, extra.to_string());
+  }
+  for (auto const& extra : meta.context->extra) {
+    std::format_to(std::back_inserter(line), "  {} = {}\n", extra.name, extra.to_string());
+  }
+  state->append(line, LogLevel::CONTEXT);
+}
+
+void FileSink::exit_context(Metadata const& meta, bool handover) {
+  auto& line = scratch();
+  std::format_to(std::back_inserter(line), "exited {}\n", meta.context->name);
+  state->append(line, LogLevel::CONTEXT);
+}
+
+void FileSink::flush() {
+  state->flush();
+}
+
+FileSink::Stats FileSink::stats() const {
+  return {.writes    = state->writes.load(std::memory_order_relaxed),
+          .bytes     = state->bytes.load(std::memory_order_relaxed),
+          .syncs     = state->syncs.load(std::memory_order_relaxed),
+          .rotations = state->rotations.load(std::memory_order_relaxed)};
+}
+}  // namespace rsl::logging
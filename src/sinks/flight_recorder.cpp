@@ -0,0 +1,397 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <rsl/logging/crash.hpp>
+#include <rsl/logging/sinks.hpp>
+
+namespace rsl::logging {
+namespace {
+struct Header {
+  Timestamp timestamp;
+  std::uint64_t context_id;
+  std::thread::id thread;
+  rsl::source_location sloc;
+  Callsite const* callsite;
+  LogLevel severity;
+  std::uint16_t text_size;
+};
+static_assert(std::is_trivially_copyable_v<Header>);
+
+// Written by the owning thread only. `sequence` is odd while the record is being written, dumps
+// running concurrently discard records whose sequence changed while they were copied.
+struct alignas(64) Record {
+  std::atomic<std::uint32_t> sequence{0};
+  Header header;
+  char text[FlightRecorderSink::record_size - sizeof(std::uint64_t) - sizeof(Header)];
+};
+static_assert(sizeof(Record) == FlightRecorderSink::record_size);
+
+struct Snapshot {
+  Header header;
+  std::string text;
+};
+
+struct Ring {
+  enum Status : std::uint8_t { FREE, ACTIVE, RELEASED };
+
+  // RELEASED rings belong to exited threads, they are kept for dumps until reused
+  std::atomic<Status> status{FREE};
+  std::atomic<std::uint64_t> head{0};
+  // records before `tail` have been cleared
+  std::atomic<std::uint64_t> tail{0};
+  std::span<Record> records;
+
+  void write(Event const& event) {
+    auto const position = head.load(std::memory_order_relaxed);
+    auto& record        = records[position % records.size()];
+    auto const sequence = record.sequence.load(std::memory_order_relaxed);
+    record.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    auto const& meta = event.meta;
+    auto const text  = event.text();
+    auto const size  = std::min(text.size(), sizeof(record.text));
+    std::memcpy(record.text, text.data(), size);
+    record.header = Header{.timestamp  = meta.timestamp,
+                           .context_id = meta.context->id,
+                           .thread     = meta.thread_id,
+                           .sloc       = meta.sloc,
+                           .callsite   = meta.callsite,
+                           .severity   = meta.severity,
+                           .text_size  = static_cast<std::uint16_t>(size)};
+
+    record.sequence.store(sequence + 2, std::memory_order_release);
+    head.store(position + 1, std::memory_order_release);
+  }
+
+  void collect(std::vector<Snapshot>& out) const {
+    auto const end   = head.load(std::memory_order_acquire);
+    auto const count = std::min<std::uint64_t>(end, records.size());
+    auto const start = std::max(end - count, tail.load(std::memory_order_relaxed));
+    for (auto position = start; position < end; ++position) {
+      auto const& record  = records[position % records.size()];
+      auto const sequence = record.sequence.load(std::memory_order_acquire);
+      if (sequence % 2 != 0) {
+        continue;
+      }
+
+      Snapshot snapshot{.header = record.header, .text = {}};
+      snapshot.text.assign(record.text, std::min<std::size_t>(snapshot.header.text_size,
+                                                              sizeof(record.text)));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (record.sequence.load(std::memory_order_relaxed) == sequence) {
+        out.push_back(std::move(snapshot));
+      }
+    }
+  }
+};
+
+// Set while this thread replays a dump into an output. The output may contain a recorder, the
+// replayed events must neither be recorded again nor trigger another dump.
+thread_local bool replaying = false;
+
+// write end of the pipe the signal handler pokes, only one recorder may listen for a signal
+std::atomic<int> signal_pipe{-1};
+
+extern "C" void on_dump_signal(int) {
+  auto const fd = signal_pipe.load(std::memory_order_relaxed);
+  if (fd >= 0) {
+    char const byte = 0;
+    (void)::write(fd, &byte, 1);
+  }
+}
+}  // namespace
+
+struct FlightRecorderSink::State {
+  Options options;
+  std::size_t index;
+  std::unique_ptr<Record[]> storage;
+  std::unique_ptr<Ring[]> rings;
+  mutable std::mutex dump_mutex;
+
+  int pipe_fds[2] = {-1, -1};
+  struct sigaction previous{};
+  std::jthread watcher;
+
+  explicit State(Options options)
+      : options(std::move(options))
+      , index(next_index.fetch_add(1, std::memory_order_relaxed))
+      , storage(std::make_unique<Record[]>(this->options.records_per_thread *
+                                           this->options.max_threads))
+      , rings(std::make_unique<Ring[]>(this->options.max_threads)) {
+    for (std::size_t idx = 0; idx < this->options.max_threads; ++idx) {
+      rings[idx].records = {storage.get() + idx * this->options.records_per_thread,
+                            this->options.records_per_thread};
+    }
+    if (this->options.signal != 0) {
+      listen(this->options.signal);
+    }
+    if (this->options.dump_on_fatal) {
+      register_crash_hook(&State::on_crash, this);
+    }
+  }
+
+  State(State const&)            = delete;
+  State& operator=(State const&) = delete;
+
+  ~State() {
+    unregister_crash_hook(&State::on_crash, this);
+    if (pipe_fds[1] >= 0) {
+      ::sigaction(options.signal, &previous, nullptr);
+      signal_pipe.store(-1, std::memory_order_relaxed);
+      watcher.request_stop();
+      watcher.join();
+      ::close(pipe_fds[0]);
+      ::close(pipe_fds[1]);
+    }
+  }
+
+  void listen(int signal) {
+    int expected = -1;
+    if (::pipe(pipe_fds) != 0) {
+      throw std::system_error(errno, std::generic_category(), "could not create signal pipe");
+    }
+    for (int fd : pipe_fds) {
+      ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+      ::fcntl(fd, F_SETFL, O_NONBLOCK);
+    }
+    if (not signal_pipe.compare_exchange_strong(expected, pipe_fds[1])) {
+      ::close(pipe_fds[0]);
+      ::close(pipe_fds[1]);
+      pipe_fds[0] = pipe_fds[1] = -1;
+      throw std::logic_error("another FlightRecorderSink already listens for a signal");
+    }
+
+    struct sigaction action{};
+    action.sa_handler = on_dump_signal;
+    action.sa_flags   = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    ::sigaction(signal, &action, &previous);
+
+    // dumping is not async-signal-safe, the handler only wakes this thread
+    watcher = std::jthread([this](std::stop_token stop) {
+      while (not stop.stop_requested()) {
+        pollfd fd{.fd = pipe_fds[0], .events = POLLIN, .revents = 0};
+        if (::poll(&fd, 1, 100) > 0) {
+          char buffer[64];
+          while (::read(pipe_fds[0], buffer, sizeof(buffer)) > 0) {}
+          dump();
+        }
+      }
+    });
+  }
+
+  // Like `dump`, but without sorting or allocating. Rings are written out one after another.
+  static void on_crash(void* data, std::string_view fatal_line) {
+    auto const& state = *static_cast<State const*>(data);
+    auto const fd     = state.options.path.empty()
+                            ? STDERR_FILENO
+                            : ::open(state.options.path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+      return;
+    }
+
+    _impl::SignalSafeBuffer<FlightRecorderSink::record_size + 512> line;
+    for (std::size_t idx = 0; idx < state.options.max_threads; ++idx) {
+      auto const& ring = state.rings[idx];
+      if (ring.status.load(std::memory_order_acquire) == Ring::FREE) {
+        continue;
+      }
+      auto const end   = ring.head.load(std::memory_order_acquire);
+      auto const count = std::min<std::uint64_t>(end, ring.records.size());
+      auto const start = std::max(end - count, ring.tail.load(std::memory_order_relaxed));
+      for (auto position = start; position < end; ++position) {
+        auto const& record = ring.records[position % ring.records.size()];
+        auto const& header = record.header;
+        line.clear();
+        line << std::uint64_t(header.timestamp.unix_ns()) << " " << level_name(header.severity)
+             << " (" << header.context_id << ") " << std::string_view(header.sloc.file) << ":"
+             << std::uint64_t(header.sloc.line) << " "
+             << std::string_view(record.text, std::min<std::size_t>(header.text_size,
+                                                                    sizeof(record.text)))
+             << "\n";
+        _impl::write_all(fd, line.view());
+      }
+    }
+    _impl::write_all(fd, fatal_line);
+    if (fd != STDERR_FILENO) {
+      ::close(fd);
+    }
+  }
+
+  Ring* claim() {
+    for (auto wanted : {Ring::FREE, Ring::RELEASED}) {
+      for (std::size_t idx = 0; idx < options.max_threads; ++idx) {
+        auto expected = wanted;
+        if (rings[idx].status.compare_exchange_strong(expected, Ring::ACTIVE)) {
+          return &rings[idx];
+        }
+      }
+    }
+    return nullptr;
+  }
+
+  std::vector<Snapshot> collect() const {
+    std::vector<Snapshot> snapshots;
+    for (std::size_t idx = 0; idx < options.max_threads; ++idx) {
+      if (rings[idx].status.load(std::memory_order_acquire) != Ring::FREE) {
+        rings[idx].collect(snapshots);
+      }
+    }
+    std::ranges::stable_sort(snapshots, {}, [](Snapshot const& s) { return s.header.timestamp; });
+    return snapshots;
+  }
+
+  void dump(std::FILE* stream) const {
+    auto _ = std::lock_guard(dump_mutex);
+    std::string line;
+    for (auto const& [header, text] : collect()) {
+      line.clear();
+      std::format_to(std::back_inserter(line),
+                     "{} {} ({}) {}:{} {}\n",
+                     header.timestamp,
+                     level_name(header.severity),
+                     header.context_id,
+                     std::string_view(header.sloc.file),
+                     header.sloc.line,
+                     text);
+      std::fwrite(line.data(), 1, line.size(), stream);
+    }
+    std::fflush(stream);
+  }
+
+  void dump() const {
+    if (options.path.empty()) {
+      dump(stderr);
+      return;
+    }
+    if (auto* file = std::fopen(options.path.c_str(), "ab")) {
+      dump(file);
+      std::fclose(file);
+    }
+  }
+
+  void release(Ring& ring) { ring.status.store(Ring::RELEASED, std::memory_order_release); }
+
+  // The ring this thread records into, released once the thread exits. Threads do not keep the
+  // recorder alive, a ring of a destroyed recorder is gone with it.
+  struct Attachment {
+    std::weak_ptr<State> state;
+    Ring* ring    = nullptr;
+    bool attached = false;
+
+    Attachment() = default;
+    Attachment(std::weak_ptr<State> state, Ring* ring)
+        : state(std::move(state))
+        , ring(ring)
+        , attached(true) {}
+    Attachment(Attachment&& other) noexcept
+        : state(std::move(other.state))
+        , ring(std::exchange(other.ring, nullptr))
+        , attached(std::exchange(other.attached, false)) {}
+    Attachment& operator=(Attachment&& other) noexcept {
+      std::swap(state, other.state);
+      std::swap(ring, other.ring);
+      std::swap(attached, other.attached);
+      return *this;
+    }
+
+    ~Attachment() {
+      if (ring == nullptr) {
+        return;
+      }
+      if (auto owner = state.lock()) {
+        owner->release(*ring);
+      }
+    }
+  };
+
+  static Ring* local_ring(std::shared_ptr<State> const& state) {
+    // indexed by recorder, indices are never reused. Grows once per thread and recorder.
+    thread_local std::vector<Attachment> attachments;
+    if (attachments.size() <= state->index) {
+      attachments.resize(state->index + 1);
+    }
+    auto& attachment = attachments[state->index];
+    if (not attachment.attached) {
+      attachment = Attachment(state, state->claim());
+    }
+    return attachment.ring;
+  }
+
+  static inline std::atomic<std::size_t> next_index{0};
+};
+
+FlightRecorderSink::FlightRecorderSink(Options options)
+    : state(std::make_shared<State>(std::move(options))) {}
+
+void FlightRecorderSink::emit_event(Event const& event) {
+  if (replaying) {
+    return;
+  }
+  if (auto* ring = State::local_ring(state)) {
+    ring->write(event);
+  } else {
+    // every ring is taken by another thread
+    report_dropped();
+  }
+  if (state->options.dump_on_fatal && event.meta.severity >= LogLevel::FATAL) {
+    state->dump();
+  }
+}
+
+void FlightRecorderSink::dump() const {
+  state->dump();
+}
+
+void FlightRecorderSink::dump(std::FILE* stream) const {
+  state->dump(stream);
+}
+
+void FlightRecorderSink::dump(OutputBase& output) const {
+  if (replaying) {
+    return;
+  }
+  auto _ = std::lock_guard(state->dump_mutex);
+  struct Replay {
+    Replay() { replaying = true; }
+    ~Replay() { replaying = false; }
+  } replay;
+  for (auto const& [header, text] : state->collect()) {
+    auto meta = Metadata{.severity  = header.severity,
+                         .timestamp = header.timestamp,
+                         .thread_id = header.thread,
+                         .sloc      = header.sloc,
+                         .callsite  = header.callsite};
+    output.emit(Event(std::move(meta), ::rsl::format("{}", text)));
+  }
+}
+
+void FlightRecorderSink::clear() {
+  for (std::size_t idx = 0; idx < state->options.max_threads; ++idx) {
+    auto& ring = state->rings[idx];
+    ring.tail.store(ring.head.load(std::memory_order_acquire), std::memory_order_relaxed);
+  }
+}
+}  // namespace rsl::logging
@@ -0,0 +1,190 @@
+#include <cerrno>
+#include <charconv>
+#include <thread>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <system_error>
+
+#include <rsl/logging/sinks.hpp>
+#include <rsl/logging/level.hpp>
+#include <rsl/logging/_impl/json.hpp>
+
+namespace rsl::logging {
+namespace json = _impl::json;
+
+namespace {
+std::string& scratch() {
+  thread_local std::string buffer;
+  buffer.clear();
+  return buffer;
+}
+
+void put_integer(std::string& out, auto value) {
+  char buffer[24];
+  auto [end, ec] = std::to_chars(std::begin(buffer), std::end(buffer), value);
+  out.append(buffer, end);
+}
+
+void put_key(std::string& out, std::string_view key) {
+  out += ',';
+  json::write_string(out, key);
+  out += ':';
+}
+
+void put_fields(std::string& out, std::string_view key, ExtraFields const& fields) {
+  put_key(out, key);
+  out += '{';
+  bool first = true;
+  for (auto const& field : fields) {
+    if (not first) {
+      out += ',';
+    }
+    first = false;
+    json::write_string(out, field.name);
+    out += ':';
+    field.to_json(out);
+  }
+  out += '}';
+}
+
+void put_location(std::string& out, rsl::source_location const& sloc) {
+  put_key(out, "file");
+  json::write_string(out, sloc.file);
+  put_key(out, "line");
+  put_integer(out, sloc.line);
+  put_key(out, "function");
+  json::write_string(out, sloc.function);
+}
+
+void put_header(std::string& out, std::string_view type, Metadata const& meta) {
+  out += "{\"type\":";
+  json::write_string(out, type);
+  put_key(out, "timestamp");
+  put_integer(out, meta.timestamp.unix_ns());
+  put_key(out, "thread");
+  put_integer(out, std::hash<std::thread::id>{}(meta.thread_id));
+}
+
+void put_span_id(std::string& out, std::uint64_t id) {
+  char span_id[16];
+  write_span_id(span_id, id);
+  json::write_string(out, std::string_view(span_id, sizeof(span_id)));
+}
+
+void put_context(std::string& out, Context const& context) {
+  out += "{\"id\":";
+  put_span_id(out, context.id);
+  if (context.remote_parent != 0) {
+    put_key(out, "parent_span_id");
+    put_span_id(out, context.remote_parent);
+  }
+  if (context.trace_id.is_valid()) {
+    char trace_id[32];
+    context.trace_id.write(trace_id);
+    put_key(out, "trace_id");
+    json::write_string(out, std::string_view(trace_id, sizeof(trace_id)));
+  }
+  put_key(out, "name");
+  json::write_string(out, context.name);
+  put_fields(out, "arguments", context.arguments);
+  put_fields(out, "extra", context.extra);
+  out += '}';
+}
+}  // namespace
+
+struct JsonLinesSink::State {
+  std::FILE* stream;
+  bool owning;
+
+  explicit State(std::FILE* stream) : stream(stream), owning(false) {}
+  explicit State(std::filesystem::path const& path)
+      : stream(std::fopen(path.c_str(), "ab"))
+      , owning(true) {
+    if (stream == nullptr) {
+      throw std::system_error(errno, std::generic_category(), "could not open " + path.string());
+    }
+    std::setvbuf(stream, nullptr, _IOFBF, 1U << 20U);
+  }
+
+  State(State const&)            = delete;
+  State& operator=(State const&) = delete;
+
+  ~State() {
+    if (owning) {
+      std::fclose(stream);
+    } else {
+      std::fflush(stream);
+    }
+  }
+
+  // a single fwrite per line keeps lines from different threads apart
+  void write(std::string& line) {
+    line += '\n';
+    if (std::fwrite(line.data(), 1, line.size(), stream) == line.size()) {
+      report_bytes(line.size());
+    } else {
+      report_dropped();
+    }
+  }
+};
+
+JsonLinesSink::JsonLinesSink(std::FILE* stream) : state(std::make_shared<State>(stream)) {}
+JsonLinesSink::JsonLinesSink(std::filesystem::path const& path)
+    : state(std::make_shared<State>(path)) {}
+
+void JsonLinesSink::emit_event(Event const& event) {
+  auto const& meta = event.meta;
+  auto& line       = scratch();
+  put_header(line, "event", meta);
+  put_key(line, "severity");
+  json::write_string(line, level_name(meta.severity));
+  put_location(line, meta.sloc);
+  put_key(line, "message");
+  json::write_string(line, event.text());
+  put_fields(line, "arguments", *meta.arguments);
+
+  put_key(line, "context");
+  line += '[';
+  for (auto const* context = &*meta.context; context != nullptr; context = context->parent) {
+    if (context != &*meta.context) {
+      line += ',';
+    }
+    put_context(line, *context);
+  }
+  line += ']';
+  line += '}';
+  state->write(line);
+}
+
+void JsonLinesSink::enter_context(Metadata const& meta, bool handover) {
+  auto& line = scratch();
+  put_header(line, "enter", meta);
+  put_key(line, "handover");
+  line += handover ? "true" : "false";
+  put_location(line, meta.context->sloc);
+  put_key(line, "context");
+  put_context(line, *meta.context);
+  line += '}';
+  state->write(line);
+}
+
+void JsonLinesSink::exit_context(Metadata const& meta, bool handover) {
+  auto& line = scratch();
+  put_header(line, "exit", meta);
+  put_key(line, "handover");
+  line += handover ? "true" : "false";
+  put_key(line, "context");
+  line += "{\"id\":";
+  put_span_id(line, meta.context->id);
+  put_key(line, "name");
+  json::write_string(line, meta.context->name);
+  line += "}}";
+  state->write(line);
+}
+
+void JsonLinesSink::flush() {
+  std::fflush(state->stream);
+}
+}  // namespace rsl::logging
@@ -1,73 +1,160 @@
+#include <sys/uio.h>
 #include <systemd/sd-journal.h>
 #include <rsl/logging/sinks.hpp>
-#include <print>
+
+#include <charconv>
+#include <concepts>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace rsl::logging {
 namespace {
-std::size_t level_to_syslog_level(LogLevel level) {
+std::string_view priority_field(LogLevel level) {
   switch (level) {
     using enum LogLevel;
-    case FATAL: return 2;
-    case ERROR: return 3;
-    case WARNING: return 4;
-    case INFO: return 6;
-    case DEBUG: return 7;
-    default: return 7;
+    case FATAL: return "PRIORITY=2";
+    case ERROR: return "PRIORITY=3";
+    case WARNING: return "PRIORITY=4";
+    case INFO: return "PRIORITY=6";
+    case DEBUG: return "PRIORITY=7";
+    default: return "PRIORITY=7";
   }
 }
 
-std::string format_name(std::string name, ExtraFields const& arguments) {
-  if (not arguments.is_empty()) {
-    name = name.substr(0, name.find('('));
-    name += "(";
-    bool first = true;
-    for (auto const& arg : arguments) {
-      if (not first) {
-        name += ", ";
-      } else {
-        first = false;
-      }
-      name += std::format("{} {}={}", arg.type_name(), arg.name, arg.to_repr());
+void append(std::string& out, std::string_view value) {
+  out += value;
+}
+
+void append(std::string& out, std::integral auto value) {
+  char buffer[24];
+  auto [end, ec] = std::to_chars(std::begin(buffer), std::end(buffer), value);
+  out.append(buffer, end);
+}
+
+void append_function(std::string& out, std::string_view function, ExtraFields const& arguments) {
+  if (arguments.is_empty()) {
+    out += function;
+    return;
+  }
+
+  out += function.substr(0, function.find('('));
+  out += '(';
+  bool first = true;
+  for (auto const& arg : arguments) {
+    if (not first) {
+      out += ", ";
     }
-    name += ")";
+    first = false;
+    out += arg.type_name();
+    out += ' ';
+    out += arg.name;
+    out += '=';
+    arg.to_repr(out);
   }
-  return name;
+  out += ')';
 }
+
+// Per-thread scratch space for one journal entry. All fields are written into `arena` first,
+// iovecs are only built once it can no longer reallocate. The buffers keep their capacity,
+// so steady-state logging does not allocate.
+struct Journal {
+  std::string arena;
+  std::vector<std::pair<std::size_t, std::size_t>> fields;
+  std::vector<iovec> iovecs;
+
+  static Journal& local() {
+    thread_local Journal journal = [] {
+      Journal journal;
+      journal.arena.reserve(4096);
+      journal.fields.reserve(32);
+      journal.iovecs.reserve(32);
+      return journal;
+    }();
+    return journal;
+  }
+
+  void clear() {
+    arena.clear();
+    fields.clear();
+  }
+
+  template <typename... Ts>
+  void add(Ts const&... parts) {
+    auto start = arena.size();
+    (append(arena, parts), ...);
+    fields.emplace_back(start, arena.size() - start);
+  }
+
+  // NUL-terminated string, returns its offset into the arena
+  template <typename... Ts>
+  std::size_t add_c_string(Ts const&... parts) {
+    auto start = arena.size();
+    (append(arena, parts), ...);
+    arena += '\0';
+    return start;
+  }
+
+  void add_upper(std::string_view name, Field const& value) {
+    auto start = arena.size();
+    for (char c : name) {
+      arena += (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+    arena += '=';
+    value.to_string(arena);
+    fields.emplace_back(start, arena.size() - start);
+  }
+
+  std::span<iovec const> finish() {
+    iovecs.clear();
+    for (auto [offset, size] : fields) {
+      iovecs.push_back({arena.data() + offset, size});
+    }
+    return iovecs;
+  }
+};
 }  // namespace
 
 void SystemdSink::emit_event(Event const& event) {
-  std::vector<std::string> fields{"CONTAINER=devcontainer"};
-  fields.push_back(std::format("PRIORITY={}", level_to_syslog_level(event.meta.severity)));
-  fields.push_back("MESSAGE=" + std::string(event.text));
-
-  fields.push_back(std::format("CONTEXT_FILE={}", event.meta.context.sloc.file));
-  fields.push_back(std::format("CONTEXT_LINE={}", event.meta.context.sloc.line));
-  fields.push_back(std::format("CONTEXT_UID={}", event.meta.context.id));
-  fields.push_back(std::format("CONTEXT_NAME={}", event.meta.context.name));
-  fields.push_back("CONTEXT_FUNC=" + format_name(std::string(event.meta.context.sloc.function), event.meta.context.arguments));
-
-  std::string func_name = format_name(std::string(event.meta.sloc.function), event.meta.arguments);
-  for (auto const& arg : event.meta.context.extra) {
-    fields.push_back(std::format("{}={}",
-                                 arg.name | std::views::transform([](unsigned char c) {
-                                   return static_cast<char>(std::toupper(c));
-                                 }) | std::ranges::to<std::string>(),
-                                 arg.to_string()));
-  }
+  auto const& context = *event.meta.context;
+  auto& journal       = Journal::local();
+  journal.clear();
+
+  journal.add("CONTAINER=devcontainer");
+  journal.add(priority_field(event.meta.severity));
+  journal.add("MESSAGE=", event.text());
+
+  journal.add("CONTEXT_FILE=", std::string_view(context.sloc.file));
+  journal.add("CONTEXT_LINE=", context.sloc.line);
+  journal.add("CONTEXT_UID=", context.id);
+  journal.add("CONTEXT_NAME=", std::string_view(context.name));
+  // rendered per event, keeping it per context would cost on every enter, exit and handover
+  auto start = journal.arena.size();
+  journal.arena += "CONTEXT_FUNC=";
+  append_function(journal.arena, context.sloc.function, context.arguments);
+  journal.fields.emplace_back(start, journal.arena.size() - start);
 
-  std::vector<struct iovec> iovecs;
-  iovecs.reserve(fields.size());
-  for (auto const& field : fields) {
-    iovecs.emplace_back((void*)field.c_str(), field.size());
+  for (auto const& arg : context.extra) {
+    journal.add_upper(arg.name, arg);
   }
 
-  sd_journal_sendv_with_location(std::format("CODE_FILE={}", event.meta.sloc.file).c_str(),
-                                 std::format("CODE_LINE={}", event.meta.sloc.line).c_str(),
-                                 func_name.c_str(),
-                                 iovecs.data(),
-                                 int(iovecs.size()));
-}
+  auto code_file = journal.add_c_string("CODE_FILE=", std::string_view(event.meta.sloc.file));
+  auto code_line = journal.add_c_string("CODE_LINE=", event.meta.sloc.line);
+  auto code_func = journal.arena.size();
+  append_function(journal.arena, event.meta.sloc.function, *event.meta.arguments);
+  journal.arena += '\0';
 
-void SystemdSink::enter_context(Metadata const& meta, bool handover) {}
-void SystemdSink::exit_context(Metadata const& meta, bool handover) {}
-}  // namespace rsl::logging
\ No newline at end of file
+  auto iovecs = journal.finish();
+  auto const result = sd_journal_sendv_with_location(journal.arena.data() + code_file,
+                                                    journal.arena.data() + code_line,
+                                                    journal.arena.data() + code_func,
+                                                    iovecs.data(),
+                                                    int(iovecs.size()));
+  if (result < 0) {
+    report_dropped();
+  }
+}
+}  // namespace rsl::logging
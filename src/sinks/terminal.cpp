@@ -1,23 +1,224 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <chrono>
-#include <print>
+#include <condition_variable>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <rsl/logging/crash.hpp>
 #include <rsl/logging/sinks.hpp>
 
 namespace rsl::logging {
-void TerminalSink::emit_event(Event const& event) {
-  std::println("{} ({: >8} {}) {}", event.meta.timestamp, event.meta.context.name, event.meta.context.id, std::string(event.text));
+namespace {
+constexpr std::size_t flush_lines = 64;
+constexpr std::size_t flush_bytes = 16U << 10U;
+constexpr auto flush_interval     = std::chrono::milliseconds(50);
+
+bool use_colors() {
+  static bool const enabled = ::isatty(STDOUT_FILENO) == 1;
+  return enabled;
 }
 
-void TerminalSink::enter_context(Metadata const& meta, bool handover) {
-  std::println("entered {}", meta.context.name);
-  for (auto const& extra : meta.context.arguments) {
-    std::println("  {} = {}", extra.name, extra.to_string());
+std::string_view color_for(LogLevel level) {
+  switch (level) {
+    using enum LogLevel;
+    case TRACE:
+    case DEBUG: return "\033[2m";
+    case WARNING: return "\033[33m";
+    case ERROR: return "\033[31m";
+    case FATAL: return "\033[1;31m";
+    default: return "";
+  }
+}
+
+// Lines formatted by one thread. Only whole lines are ever appended, so writing out the
+// buffer in one go keeps lines from different threads apart.
+struct Buffer {
+  std::mutex mutex;
+  std::string data;
+  std::size_t lines = 0;
+  std::atomic<bool> closed{false};
+};
+
+class Writer {
+  std::mutex write_mutex;
+
+  std::mutex mutex;
+  std::vector<std::shared_ptr<Buffer>> buffers;
+  std::condition_variable_any wake;
+  std::jthread flusher;
+
+  void run(std::stop_token stop) {
+    while (not stop.stop_requested()) {
+      {
+        auto lock = std::unique_lock(mutex);
+        wake.wait_for(lock, stop, flush_interval, [] { return false; });
+      }
+      flush_all();
+    }
+  }
+
+  // the locks taken here are never released, the process is going down
+  static void on_crash(void* data, std::string_view fatal_line) {
+    auto& writer = *static_cast<Writer*>(data);
+    if (_impl::try_lock_briefly(writer.mutex)) {
+      for (auto const& buffer : writer.buffers) {
+        if (_impl::try_lock_briefly(buffer->mutex)) {
+          _impl::write_all(STDOUT_FILENO, buffer->data);
+          buffer->data.clear();
+        }
+      }
+    }
+    _impl::write_all(STDOUT_FILENO, fatal_line);
+  }
+
+public:
+  Writer() : flusher([this](std::stop_token stop) { run(std::move(stop)); }) {
+    register_crash_hook(&Writer::on_crash, this);
+  }
+
+  Writer(Writer const&)            = delete;
+  Writer& operator=(Writer const&) = delete;
+
+  ~Writer() {
+    unregister_crash_hook(&Writer::on_crash, this);
+    flusher.request_stop();
+    flusher.join();
+    flush_all();
+  }
+
+  static Writer& instance() {
+    static Writer writer;
+    return writer;
+  }
+
+  std::shared_ptr<Buffer> attach() {
+    auto buffer = std::make_shared<Buffer>();
+    buffer->data.reserve(flush_bytes);
+    auto _ = std::lock_guard(mutex);
+    buffers.push_back(buffer);
+    return buffer;
   }
-  for (auto const& extra : meta.context.extra) {
-    std::println("  {} = {}", extra.name, extra.to_string());
+
+  // `buffer.mutex` must be held
+  void write_out(Buffer& buffer) {
+    if (buffer.data.empty()) {
+      return;
+    }
+
+    auto _    = std::lock_guard(write_mutex);
+    auto data = std::string_view(buffer.data);
+    while (not data.empty()) {
+      auto result = ::write(STDOUT_FILENO, data.data(), data.size());
+      if (result < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        break;
+      }
+      data.remove_prefix(static_cast<std::size_t>(result));
+    }
+    buffer.data.clear();
+    buffer.lines = 0;
+  }
+
+  void flush_all() {
+    std::vector<std::shared_ptr<Buffer>> snapshot;
+    {
+      auto _   = std::lock_guard(mutex);
+      snapshot = buffers;
+    }
+
+    for (auto const& buffer : snapshot) {
+      auto _ = std::lock_guard(buffer->mutex);
+      write_out(*buffer);
+    }
+
+    // buffers of exited threads have been written out above, drop them
+    auto _ = std::lock_guard(mutex);
+    std::erase_if(buffers, [](auto const& buffer) {
+      return buffer->closed.load(std::memory_order_acquire) && buffer->data.empty();
+    });
+  }
+};
+
+struct LocalBuffer {
+  std::shared_ptr<Buffer> buffer = Writer::instance().attach();
+
+  ~LocalBuffer() { buffer->closed.store(true, std::memory_order_release); }
+};
+
+// Formats into the calling thread's buffer. Events and context lines share the one buffer, so
+// they are written out in the order they were emitted.
+void append(LogLevel severity, void (*format)(std::string&, void const*), void const* closure) {
+  thread_local LocalBuffer local;
+  auto& buffer = *local.buffer;
+
+  auto _      = std::lock_guard(buffer.mutex);
+  auto before = buffer.data.size();
+  format(buffer.data, closure);
+  buffer.lines += static_cast<std::size_t>(
+      std::ranges::count(std::string_view(buffer.data).substr(before), '\n'));
+  report_bytes(buffer.data.size() - before);
+
+  if (severity >= LogLevel::WARNING || buffer.lines >= flush_lines ||
+      buffer.data.size() >= flush_bytes) {
+    Writer::instance().write_out(buffer);
   }
 }
 
+// `format` appends whole lines to the string it is passed
+template <typename F>
+void append(LogLevel severity, F const& format) {
+  append(
+      severity,
+      [](std::string& out, void const* closure) { (*static_cast<F const*>(closure))(out); },
+      static_cast<void const*>(std::addressof(format)));
+}
+}  // namespace
+
+void TerminalSink::emit_event(Event const& event) {
+  append(event.meta.severity, [&](std::string& out) {
+    auto color = use_colors() ? color_for(event.meta.severity) : std::string_view();
+    std::format_to(std::back_inserter(out),
+                   "{}{} ({: >8} {}) {}{}\n",
+                   color,
+                   event.meta.timestamp,
+                   event.meta.context->name,
+                   event.meta.context->id,
+                   event.text(),
+                   color.empty() ? "" : "\033[0m");
+  });
+}
+
+void TerminalSink::enter_context(Metadata const& meta, bool handover) {
+  append(LogLevel::CONTEXT, [&](std::string& out) {
+    std::format_to(std::back_inserter(out), "entered {}\n", meta.context->name);
+    for (auto const& extra : meta.context->arguments) {
+      std::format_to(std::back_inserter(out), "  {} = {}\n", extra.name, extra.to_string());
+    }
+    for (auto const& extra : meta.context->extra) {
+      std::format_to(std::back_inserter(out), "  {} = {}\n", extra.name, extra.to_string());
+    }
+  });
+}
+
 void TerminalSink::exit_context(Metadata const& meta, bool handover) {
-  std::println("exited {}", meta.context.name);
+  append(LogLevel::CONTEXT, [&](std::string& out) {
+    std::format_to(std::back_inserter(out), "exited {}\n", meta.context->name);
+  });
+}
+
+void TerminalSink::flush() {
+  Writer::instance().flush_all();
 }
-}  // namespace rsl::logging
\ No newline at end of file
+}  // namespace rsl::logging
@@ -0,0 +1,147 @@
+#define RSL_DOLLAR_MACROS
+#include <coroutine>
+#include <exception>
+
+#include <rsl/log>
+#include <rsl/logging/filters.hpp>
+#include <rsl/logging/sinks.hpp>
+#include <rsl/test>
+
+#include "counter.hpp"
+
+namespace rsl::logging {
+namespace _test_allocations {
+struct NullTag {};
+}  // namespace _test_allocations
+
+template <>
+constexpr inline auto selected_logger<_test_allocations::NullTag> = NullLogger();
+}  // namespace rsl::logging
+
+// Fixed per-operation allocation budgets. A failure here means a change added heap allocations
+// to a path that is expected to run for every event - raise a budget only deliberately.
+namespace rsl::logging::_test_allocations {
+using testing::count_allocations;
+
+struct DiscardSink : Sink {
+  void emit_event(Event const&) {}
+};
+
+Output<DiscardSink>& discard_output() {
+  static auto output = Output(DiscardSink());
+  return output;
+}
+
+void three_ints(int a, int b, int c) {
+  $info("{} {} {}", a, b, c);
+}
+
+void kwargs_context(int request, int attempt) {
+  RSL_LOG_CONTEXT("kwargs", rsl::log_level::INHERIT, id = request, retry = attempt);
+}
+
+struct Task {
+  struct promise_type {
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+rsl::co_trace<Task> suspend_forever() {
+  auto _ = ContextGuard("coroutine", LogLevel::INHERIT);
+  while (true) {
+    co_await std::suspend_always{};
+  }
+}
+
+[[=test]]
+void disabled_event() {
+  set_output(discard_output());
+  Context quiet{"quiet", LogLevel::ERROR};
+  quiet.enter();
+  auto const counted = count_allocations([] { rsl::info("{} {} {}", 1, 2, 3); });
+  quiet.exit();
+  ASSERT(counted.count == 0, "allocations", counted.count);
+}
+
+[[=test]]
+void null_logger() {
+  auto const counted = count_allocations([] {
+    emit_event<LogLevel::INFO, NullTag>(nullptr, current_context, "{} {} {}", 1, 2, 3);
+  });
+  ASSERT(counted.count == 0, "allocations", counted.count);
+}
+
+// captures the three parameters as fields, the sink never renders the text
+[[=test]]
+void info_with_three_ints_into_discarding_sink() {
+  set_output(discard_output());
+  auto const counted = count_allocations([] { three_ints(1, 2, 3); });
+  ASSERT(counted.count == 0, "allocations", counted.count);
+}
+
+[[=test]]
+void filter_pipeline() {
+  static auto output = Output(at_least(LogLevel::INFO) >> rate_limit(1'000'000) >> DiscardSink());
+  set_output(output);
+  auto const counted = count_allocations([] { rsl::warn("{} {} {}", 1, 2, 3); });
+  set_output(discard_output());
+  ASSERT(counted.count == 0, "allocations", counted.count);
+}
+
+// names within the small string buffer
+[[=test]]
+void context_guard() {
+  set_output(discard_output());
+  auto const counted =
+      count_allocations([] { auto _ = ContextGuard("guard", LogLevel::INHERIT); });
+  ASSERT(counted.count == 0, "allocations", counted.count);
+}
+
+// up to ExtraFields::inline_capacity arguments and keyword fields are stored inline
+[[=test]]
+void kwargs_context_within_inline_capacity() {
+  set_output(discard_output());
+  auto const counted = count_allocations([] { kwargs_context(1, 2); });
+  ASSERT(counted.count == 0, "allocations", counted.count);
+}
+
+// the coroutine's context is relinked on every resume and suspension, never copied
+[[=test]]
+void co_trace_resume_suspend() {
+  set_output(discard_output());
+  auto task          = suspend_forever();
+  auto const counted = count_allocations([&] { task.handle().resume(); });
+  ASSERT(counted.count == 0, "allocations", counted.count);
+}
+
+#ifdef RSL_LOG_SYSTEMD
+// the journal entry is assembled in a per-thread arena, contexts leave no state in the sink
+[[=test]]
+void systemd_event_and_context() {
+  static auto output = Output(SystemdSink());
+  set_output(output);
+  auto const counted = count_allocations([] {
+    Context request{"request", LogLevel::INHERIT};
+    request.enter();
+    rsl::info("{} {} {}", 1, 2, 3);
+    request.exit();
+  });
+  set_output(discard_output());
+  ASSERT(counted.count == 0, "allocations", counted.count);
+}
+#endif
+
+// cloning, ie. for the async backend, moves every field value to the heap
+[[=test]]
+void clone_allocates_once_per_field() {
+  int a = 1;
+  int b = 2;
+  auto const fields = std::array{Field("a", &a), Field("b", &b)};
+  Context context{"clone", LogLevel::INHERIT, fields};
+  auto const counted = count_allocations([&] { auto cloned = context.clone(); });
+  ASSERT(counted.count <= 2, "allocations", counted.count);
+}
+}  // namespace rsl::logging::_test_allocations
@@ -0,0 +1,114 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "counter.hpp"
+
+namespace {
+std::atomic<std::uint64_t> total_count{0};
+std::atomic<std::uint64_t> total_bytes{0};
+// trivially initialized, safe to touch from within operator new
+thread_local std::uint64_t thread_count = 0;
+thread_local std::uint64_t thread_bytes = 0;
+
+void record(std::size_t size) {
+  total_count.fetch_add(1, std::memory_order_relaxed);
+  total_bytes.fetch_add(size, std::memory_order_relaxed);
+  ++thread_count;
+  thread_bytes += size;
+}
+
+void* allocate(std::size_t size) noexcept {
+  record(size);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void* allocate(std::size_t size, std::align_val_t alignment) noexcept {
+  record(size);
+  auto const align = static_cast<std::size_t>(alignment);
+  // aligned_alloc wants a multiple of the alignment
+  auto const rounded = (size + align - 1) / align * align;
+  return std::aligned_alloc(align, rounded == 0 ? align : rounded);
+}
+}  // namespace
+
+void* operator new(std::size_t size) {
+  if (void* ptr = allocate(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+  return ::operator new(size);
+}
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept {
+  return allocate(size);
+}
+
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept {
+  return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  if (void* ptr = allocate(size, alignment)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return ::operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept {
+  return allocate(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept {
+  return allocate(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+namespace rsl::logging::testing {
+Allocations total_allocations() {
+  return {.count = total_count.load(std::memory_order_relaxed),
+          .bytes = total_bytes.load(std::memory_order_relaxed)};
+}
+
+Allocations thread_allocations() {
+  return {.count = thread_count, .bytes = thread_bytes};
+}
+}  // namespace rsl::logging::testing
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+
+// Counts heap allocations made through the global operator new. Linking counter.cpp replaces
+// the global allocation functions, only test and benchmark binaries may do so.
+
+namespace rsl::logging::testing {
+struct Allocations {
+  std::uint64_t count = 0;
+  std::uint64_t bytes = 0;
+};
+
+// made by any thread since startup
+Allocations total_allocations();
+// made by the calling thread since it started
+Allocations thread_allocations();
+
+// Allocations made by the calling thread while running `fn` once. It is called once before, so
+// lazily initialized state - thread-local buffers, generators, callsite registration - is not
+// counted. Allocations on other threads, ie. a backend thread, are not counted either.
+template <typename F>
+Allocations count_allocations(F&& fn) {
+  fn();
+  auto const before = thread_allocations();
+  fn();
+  auto const after = thread_allocations();
+  return {.count = after.count - before.count, .bytes = after.bytes - before.bytes};
+}
+}  // namespace rsl::logging::testing
@@ -0,0 +1,156 @@
+#include <cstdio>
+#include <span>
+#include <string_view>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <rsl/log>
+#include <rsl/logging/flavor/async.hpp>
+#include <rsl/test>
+
+namespace rsl::logging {
+namespace _test_async {
+struct AsyncTag {};
+struct DeferredTag {};
+}  // namespace _test_async
+
+template <>
+constexpr inline auto selected_logger<_test_async::AsyncTag> = AsyncLogger();
+template <>
+constexpr inline auto selected_logger<_test_async::DeferredTag> = DeferredLogger();
+}  // namespace rsl::logging
+
+namespace rsl::logging::_test_async {
+// only ever called on the backend thread, read after `AsyncLogger::flush()`
+struct RecordingSink : Sink {
+  std::vector<std::string>* lines;
+  // events that reached the sink before they were formatted
+  std::size_t* unrendered;
+
+  void emit_event(Event const& event) {
+    *unrendered += event.is_rendered() ? 0 : 1;
+    lines->push_back(std::string(event.text()));
+  }
+  void enter_context(Metadata const& meta, bool) { lines->push_back("enter " + meta.context->name); }
+  void exit_context(Metadata const& meta, bool) { lines->push_back("exit " + meta.context->name); }
+};
+
+std::size_t unrendered = 0;
+
+std::vector<std::string>& recorded() {
+  static std::vector<std::string> lines;
+  static auto output = Output(RecordingSink{{}, &lines, &unrendered});
+  AsyncLogger::flush();
+  set_output(output);
+  lines.clear();
+  unrendered = 0;
+  return lines;
+}
+
+[[=test]]
+void flush_waits_for_everything_submitted_before() {
+  auto& lines = recorded();
+  for (int idx = 0; idx < 2000; ++idx) {
+    emit_event<LogLevel::INFO, AsyncTag>(nullptr, current_context, "event {}", idx);
+  }
+  AsyncLogger::flush();
+  ASSERT(lines.size() == 2000, "dispatched", lines.size());
+}
+
+[[=test]]
+void events_of_one_thread_keep_their_order() {
+  constexpr int threads = 4;
+  constexpr int events  = 1000;
+  auto& lines           = recorded();
+
+  std::vector<std::thread> producers;
+  for (int thread = 0; thread < threads; ++thread) {
+    producers.emplace_back([thread] {
+      for (int idx = 0; idx < events; ++idx) {
+        emit_event<LogLevel::INFO, AsyncTag>(nullptr, current_context, "{} {}", thread, idx);
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  AsyncLogger::flush();
+
+  ASSERT(lines.size() == std::size_t(threads * events), "dispatched", lines.size());
+  std::vector<int> next(threads, 0);
+  for (auto const& line : lines) {
+    int thread = -1;
+    int idx    = -1;
+    ASSERT(std::sscanf(line.c_str(), "%d %d", &thread, &idx) == 2, line);
+    ASSERT(idx == next[thread], "thread", thread, "expected", next[thread], "got", idx);
+    ++next[thread];
+  }
+}
+
+[[=test]]
+void context_events_stay_between_their_thread_events() {
+  auto& lines = recorded();
+  std::thread([] {
+    emit_event<LogLevel::INFO, AsyncTag>(nullptr, current_context, "before");
+    Context scope{"scope", LogLevel::INHERIT};
+    scope.enter<AsyncTag>();
+    emit_event<LogLevel::INFO, AsyncTag>(nullptr, current_context, "inside");
+    scope.exit<AsyncTag>();
+    emit_event<LogLevel::INFO, AsyncTag>(nullptr, current_context, "after");
+  }).join();
+  AsyncLogger::flush();
+
+  auto const expected =
+      std::vector<std::string>{"before", "enter scope", "inside", "exit scope", "after"};
+  ASSERT(lines == expected, "order", lines.size());
+}
+
+[[=test]]
+void async_formats_on_the_calling_thread() {
+  auto& lines = recorded();
+  emit_event<LogLevel::INFO, AsyncTag>(nullptr, current_context, "{} {}", 1, 2);
+  AsyncLogger::flush();
+  ASSERT(lines.size() == 1);
+  ASSERT(unrendered == 0);
+}
+
+// the sink only runs on the backend thread, the text is rendered when it asks for it
+[[=test]]
+void deferred_formats_on_the_backend() {
+  auto& lines      = recorded();
+  std::string name = "captured";
+  emit_event<LogLevel::INFO, DeferredTag>(nullptr, current_context, "{} {}", name, 42);
+  // the record holds a copy
+  name = "changed";
+  AsyncLogger::flush();
+
+  ASSERT(lines.size() == 1);
+  ASSERT(lines[0] == "captured 42", lines[0]);
+  ASSERT(unrendered == 1, "formatted before reaching the backend");
+}
+
+// too large for the inline buffer of the record
+[[=test]]
+void deferred_spills_large_argument_packs() {
+  auto& lines     = recorded();
+  auto const text = std::string(100, 'x');
+  emit_event<LogLevel::INFO, DeferredTag>(
+      nullptr, current_context, "{} {} {} {}", text, text, std::string("moved"), "literal");
+  AsyncLogger::flush();
+
+  ASSERT(lines.size() == 1);
+  ASSERT(lines[0] == text + " " + text + " moved literal", lines[0]);
+  ASSERT(unrendered == 1);
+}
+
+// pointers and views may dangle by the time the backend formats them
+static_assert(not _impl::deferrable<char const*>);
+static_assert(not _impl::deferrable<int*>);
+static_assert(not _impl::deferrable<std::string_view>);
+static_assert(not _impl::deferrable<std::string_view const&>);
+static_assert(not _impl::deferrable<std::span<int const>>);
+static_assert(_impl::deferrable<char const (&)[8]>);
+static_assert(_impl::deferrable<std::string&>);
+static_assert(_impl::deferrable<int>);
+}  // namespace rsl::logging::_test_async
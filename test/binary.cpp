@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <rsl/log>
+#include <rsl/logging/sinks.hpp>
+#include <rsl/logging/_impl/binary_format.hpp>
+#include <rsl/test>
+
+namespace rsl::logging::_test_binary {
+namespace binary = _impl::binary;
+
+void log_attempt(int attempt) {
+  rsl::info(RSL_LOG_ARGS, "attempt {}", attempt);
+}
+
+struct Recorded {
+  std::filesystem::path path;
+  std::uint64_t context_id;
+};
+
+// one context with an argument around two events from the same callsite, written once
+Recorded const& recorded() {
+  static Recorded const result = [] {
+    auto const path    = std::filesystem::temp_directory_path() / "rsl-log-binary-test.bin";
+    auto sink          = BinaryFileSink(path);
+    // a copy shares the file, the output outlives this scope
+    static auto output = Output(BinaryFileSink(sink));
+    set_output(output);
+
+    static int user   = 7;
+    auto const fields = std::array{Field("user", &user)};
+    Context request{"request", LogLevel::INHERIT, fields};
+    request.enter();
+    log_attempt(1);
+    log_attempt(2);
+    request.exit();
+    sink.flush();
+    return Recorded{path, request.id};
+  }();
+  return result;
+}
+
+// output of the rsl-log-decode executable
+std::string decode(std::string_view format) {
+  auto const command =
+      std::string(RSL_LOG_DECODE) + " " + std::string(format) + " " + recorded().path.string();
+  auto* pipe = ::popen(command.c_str(), "r");
+  std::string out;
+  char chunk[4096];
+  while (auto read = std::fread(chunk, 1, sizeof(chunk), pipe)) {
+    out.append(chunk, read);
+  }
+  ASSERT(::pclose(pipe) == 0, "decoder failed", command);
+  return out;
+}
+
+// `needles` appear in `haystack` in this order
+bool in_order(std::string_view haystack, std::initializer_list<std::string_view> needles) {
+  std::size_t offset = 0;
+  for (auto needle : needles) {
+    offset = haystack.find(needle, offset);
+    if (offset == std::string_view::npos) {
+      return false;
+    }
+    offset += needle.size();
+  }
+  return true;
+}
+
+[[=test]]
+void decodes_to_text() {
+  auto const text = decode("--text");
+  ASSERT(in_order(text,
+                  {"entered request\n",
+                   "  user = 7\n",
+                   ") attempt 1\n",
+                   ") attempt 2\n",
+                   "exited request\n"}),
+         text);
+  ASSERT(text.contains("request " + std::to_string(recorded().context_id) + ") attempt 1"), text);
+}
+
+[[=test]]
+void decodes_to_json() {
+  auto const json = decode("--json");
+  auto const id   = std::format("{:016x}", recorded().context_id);
+  ASSERT(in_order(json,
+                  {"{\"type\":\"enter\",\"handover\":false",
+                   "\"context\":{\"id\":\"" + id + "\",\"name\":\"request\"}",
+                   "\"arguments\":{\"user\":\"7\"}",
+                   "{\"type\":\"event\"",
+                   "\"severity\":\"INFO\"",
+                   "\"function\":\"",
+                   "log_attempt",
+                   "\"message\":\"attempt 1\"",
+                   "\"arguments\":{\"attempt\":\"1\"}",
+                   "\"message\":\"attempt 2\"",
+                   "{\"type\":\"exit\""}),
+         json);
+}
+
+// every string and callsite is written once, before the first record referring to it
+[[=test]]
+void dictionary_records_precede_their_use() {
+  auto file = std::ifstream(recorded().path, std::ios::binary);
+  auto const contents =
+      std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  auto reader = binary::Reader{contents, binary::header_size};
+
+  std::vector<std::string> strings;
+  std::uint32_t callsites = 0;
+  int events              = 0;
+  while (reader.offset < contents.size()) {
+    auto const size = reader.get<std::uint32_t>();
+    auto const kind = binary::RecordKind(reader.get<std::uint8_t>());
+    ASSERT(reader.ok && reader.offset + size <= contents.size(), "truncated record");
+    auto record = binary::Reader{std::span(contents).subspan(reader.offset, size)};
+    reader.offset += size;
+
+    switch (kind) {
+      using enum binary::RecordKind;
+      case STRING: {
+        auto const id = record.get<std::uint32_t>();
+        auto value    = std::string(record.get_string());
+        ASSERT(id == strings.size(), "string ids are not sequential");
+        ASSERT(std::ranges::count(strings, value) == 0, "string written twice", value);
+        strings.push_back(value);
+        break;
+      }
+      case CALLSITE: {
+        auto const id       = record.get<std::uint32_t>();
+        auto const file     = record.get<std::uint32_t>();
+        auto const function = record.get<std::uint32_t>();
+        ASSERT(id == callsites, "callsite ids are not sequential");
+        ASSERT(file < strings.size() && function < strings.size(), "name not defined yet");
+        ++callsites;
+        break;
+      }
+      case EVENT: {
+        auto const callsite = record.get<std::uint32_t>();
+        ASSERT(callsite < callsites, "callsite not defined yet");
+        ++events;
+        break;
+      }
+      case CONTEXT: break;
+    }
+  }
+
+  ASSERT(events == 2);
+  // the context's location and the shared location of both events
+  ASSERT(callsites == 2, "callsites", callsites);
+  ASSERT(std::ranges::count(strings, "request") == 1);
+  ASSERT(std::ranges::count(strings, "attempt") == 1);
+}
+}  // namespace rsl::logging::_test_binary
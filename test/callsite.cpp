@@ -0,0 +1,52 @@
+#include <algorithm>
+
+#include <rsl/log>
+#include <rsl/test>
+
+namespace rsl::logging::_test_callsite {
+struct CountingSink : Sink {
+  int* count;
+  void emit_event(Event const&) { ++*count; }
+};
+
+void log_info() {
+  rsl::info("callsite registry test");
+}
+
+Callsite* find_callsite(std::string_view format) {
+  auto registered = callsites();
+  auto it         = std::ranges::find(registered, format, &Callsite::format);
+  return it == registered.end() ? nullptr : *it;
+}
+
+[[=test]]
+void callsites_register_on_first_use() {
+  log_info();
+
+  auto* callsite = find_callsite("callsite registry test");
+  ASSERT(callsite != nullptr, "callsite missing after running");
+  ASSERT(callsite->level == LogLevel::INFO);
+  ASSERT(callsite->scope == "rsl::logging::_test_callsite::log_info");
+  ASSERT(callsite->function.contains("log_info"));
+}
+
+[[=test]]
+void callsites_can_be_disabled() {
+  static int count   = 0;
+  static auto output = Output(CountingSink{{}, &count});
+  set_output(output);
+  count = 0;
+
+  log_info();
+  ASSERT(count == 1);
+
+  auto* callsite = find_callsite("callsite registry test");
+  callsite->disable();
+  log_info();
+  ASSERT(count == 1, "disabled callsite emitted");
+
+  callsite->enable();
+  log_info();
+  ASSERT(count == 2, "enabled callsite did not emit");
+}
+}  // namespace rsl::logging::_test_callsite
@@ -0,0 +1,50 @@
+#include <chrono>
+#include <cstdint>
+
+#include <rsl/log>
+#include <rsl/test>
+
+namespace rsl::logging::_test_clock {
+using namespace std::chrono_literals;
+
+[[=test]]
+void time_points_round_trip() {
+  auto const original  = std::chrono::system_clock::now() - 1h;
+  auto const converted = Timestamp(original).to_sys();
+#ifdef RSL_LOG_TSC_CLOCK
+  // truncated twice when converting through ticks
+  ASSERT(std::chrono::abs(converted - original) <= 1us,
+         "drifted by",
+         (converted - original).count());
+#else
+  ASSERT(converted == original);
+#endif
+}
+
+[[=test]]
+void timestamps_are_ordered() {
+  auto const earlier = Timestamp(std::chrono::system_clock::now() - 1s);
+  auto const first   = Timestamp::now();
+  auto const second  = Timestamp::now();
+  ASSERT(earlier < first);
+  ASSERT(first <= second);
+  // comparing raw values must agree with the converted times
+  ASSERT(earlier.unix_ns() < first.unix_ns());
+  ASSERT(first.unix_ns() <= second.unix_ns());
+  ASSERT(first.to_sys() - earlier.to_sys() >= 900ms);
+}
+
+// converted ticks keep their order while the calibration is refreshed in between
+[[=test]]
+void conversion_is_monotonic_across_recalibration() {
+  std::int64_t previous = _impl::ticks_to_unix_ns(_impl::read_ticks());
+  for (int idx = 0; idx < 100; ++idx) {
+    auto const before = _impl::ticks_to_unix_ns(_impl::read_ticks());
+    _impl::recalibrate_clock();
+    auto const after = _impl::ticks_to_unix_ns(_impl::read_ticks());
+    ASSERT(before >= previous, "went back before recalibrating", idx, previous, before);
+    ASSERT(after >= before, "went back across a recalibration", idx, before, after);
+    previous = after;
+  }
+}
+}  // namespace rsl::logging::_test_clock
@@ -0,0 +1,247 @@
+#include <array>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <thread>
+
+#include <rsl/log>
+#include <rsl/logging/sinks.hpp>
+#include <rsl/test>
+
+namespace rsl::logging::_test_context {
+// enters `depth` contexts below the current one, innermost last
+struct Nested {
+  std::deque<Context> contexts;
+
+  explicit Nested(std::size_t depth, LogLevel level = LogLevel::INHERIT) {
+    for (std::size_t idx = 0; idx < depth; ++idx) {
+      contexts.emplace_back("nested", level).enter();
+    }
+  }
+
+  ~Nested() {
+    while (not contexts.empty()) {
+      contexts.back().exit();
+      contexts.pop_back();
+    }
+  }
+
+  Context& innermost() { return contexts.back(); }
+};
+
+[[=test]]
+void inherits_through_deep_nesting() {
+  Context root{"root", LogLevel::WARNING};
+  root.enter();
+  {
+    auto nested = Nested(255);
+    ASSERT(nested.innermost().effective_level() == LogLevel::WARNING);
+    ASSERT(not nested.innermost().enabled_for(LogLevel::INFO));
+    ASSERT(nested.innermost().enabled_for(LogLevel::ERROR));
+  }
+  root.exit();
+}
+
+[[=test]]
+void parent_level_change_invalidates_children() {
+  Context root{"root", LogLevel::WARNING};
+  root.enter();
+  {
+    auto nested = Nested(64);
+    ASSERT(not nested.innermost().enabled_for(LogLevel::INFO));
+
+    root.set_min_level(LogLevel::DEBUG);
+    ASSERT(nested.innermost().enabled_for(LogLevel::INFO));
+
+    nested.contexts[10].set_min_level(LogLevel::ERROR);
+    ASSERT(not nested.innermost().enabled_for(LogLevel::WARNING));
+    ASSERT(nested.contexts[9].enabled_for(LogLevel::INFO));
+  }
+  root.exit();
+}
+
+[[=test]]
+void exiting_a_middle_context_relinks_children() {
+  Context root{"root", LogLevel::DEBUG};
+  root.enter();
+  Context middle{"middle", LogLevel::ERROR};
+  middle.enter();
+  Context inner{"inner", LogLevel::INHERIT};
+  inner.enter();
+  ASSERT(not inner.enabled_for(LogLevel::INFO));
+
+  // out of order, `inner` now inherits from `root`
+  middle.exit();
+  ASSERT(inner.enabled_for(LogLevel::INFO));
+
+  inner.exit();
+  root.exit();
+}
+
+// relinking refreshes this thread's contexts, the caches of other threads stay valid
+[[=test]]
+void exiting_a_middle_context_keeps_the_epoch() {
+  Context root{"root", LogLevel::DEBUG};
+  root.enter();
+  Context middle{"middle", LogLevel::ERROR};
+  middle.enter();
+  {
+    auto nested = Nested(3);
+    Context own{"own", LogLevel::WARNING};
+    own.enter();
+    Context inner{"inner", LogLevel::INHERIT};
+    inner.enter();
+    ASSERT(not nested.innermost().enabled_for(LogLevel::WARNING));
+
+    auto const epoch = _impl::context_epoch.load();
+    middle.exit();
+    ASSERT(_impl::context_epoch.load() == epoch, "exit invalidated every cached level");
+    ASSERT(nested.innermost().enabled_for(LogLevel::INFO));
+    ASSERT(not inner.enabled_for(LogLevel::INFO));
+    ASSERT(inner.enabled_for(LogLevel::WARNING));
+
+    inner.exit();
+    own.exit();
+  }
+  root.exit();
+}
+
+[[=test]]
+void unparented_context_inherits_default() {
+  Context detached{"detached", LogLevel::INHERIT};
+  ASSERT(detached.effective_level() == Context::get_default()->effective_level());
+}
+
+[[=test]]
+void foreign_thread_exit_is_diagnosed() {
+  Context context{"owned", LogLevel::INFO};
+  context.enter();
+
+  auto const before = Context::foreign_exits();
+  std::thread([&] { context.exit(); }).join();
+  ASSERT(Context::foreign_exits() == before + 1, "foreign exit not counted");
+  ASSERT(current_context == &context, "foreign exit modified the owning thread's stack");
+
+  context.exit();
+  ASSERT(current_context != &context);
+}
+
+// lazily started, resumed by hand
+struct Task {
+  struct promise_type {
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+// what the coroutine saw as current before and after its suspension
+struct Observed {
+  Context* context = nullptr;
+  Context* parent  = nullptr;
+  std::uint64_t id = 0;
+};
+
+rsl::co_trace<Task> guarded(std::array<Observed, 2>& seen) {
+  auto _  = ContextGuard("coroutine", LogLevel::INHERIT);
+  seen[0] = {current_context, current_context->parent, current_context->id};
+  co_await std::suspend_always{};
+  seen[1] = {current_context, current_context->parent, current_context->id};
+}
+
+[[=test]]
+void coroutine_context_is_handed_over() {
+  Context resumer{"resumer", LogLevel::INHERIT};
+  resumer.enter();
+  auto const before = Context::foreign_exits();
+
+  std::array<Observed, 2> seen{};
+  auto task = guarded(seen);
+  task.handle().resume();
+  ASSERT(seen[0].parent == &resumer);
+  ASSERT(current_context == &resumer, "suspension left the coroutine's context active");
+
+  Context* other_base  = nullptr;
+  Context* other_after = nullptr;
+  std::thread([&] {
+    other_base = current_context;
+    task.handle().resume();
+    other_after = current_context;
+  }).join();
+
+  ASSERT(seen[1].context == seen[0].context, "context was copied");
+  ASSERT(seen[1].id == seen[0].id, "context id changed");
+  ASSERT(seen[1].parent == other_base, "context not linked onto the resuming thread");
+  ASSERT(other_after == other_base, "context not exited on the resuming thread");
+  ASSERT(Context::foreign_exits() == before);
+  ASSERT(current_context == &resumer);
+  resumer.exit();
+}
+
+[[=test]]
+void destroying_a_suspended_coroutine_exits_its_context() {
+  Context resumer{"resumer", LogLevel::INHERIT};
+  resumer.enter();
+  auto const before = Context::foreign_exits();
+  {
+    std::array<Observed, 2> seen{};
+    auto task = guarded(seen);
+    task.handle().resume();
+    ASSERT(seen[0].context != nullptr);
+  }
+  ASSERT(Context::foreign_exits() == before);
+  ASSERT(current_context == &resumer);
+  ASSERT(resumer.child == nullptr);
+  resumer.exit();
+}
+
+// counts context events flagged as coroutine handovers
+template <bool Subscribes>
+struct HandoverSink : Sink {
+  constexpr static bool handover_events = Subscribes;
+  int* handovers;
+
+  void emit_event(Event const&) {}
+  void enter_context(Metadata const&, bool handover) { *handovers += int(handover); }
+  void exit_context(Metadata const&, bool handover) { *handovers += int(handover); }
+};
+
+// sinks handling context events subscribe unless they opt out
+struct ContextSink : Sink {
+  void emit_event(Event const&) {}
+  void exit_context(Metadata const&, bool) {}
+};
+struct EventSink : Sink {
+  void emit_event(Event const&) {}
+};
+static_assert(_impl::wants_handover<ContextSink>());
+static_assert(not _impl::wants_handover<EventSink>());
+static_assert(not _impl::wants_handover<TerminalSink>());
+static_assert(_impl::wants_handover<JsonLinesSink>());
+
+[[=test]]
+void handover_events_only_reach_subscribers() {
+  static int handovers   = 0;
+  static auto subscribed = Output(HandoverSink<true>{{}, &handovers});
+  static auto ignoring   = Output(HandoverSink<false>{{}, &handovers});
+
+  std::array<Observed, 2> seen{};
+  set_output(ignoring);
+  {
+    auto task = guarded(seen);
+    task.handle().resume();
+    task.handle().resume();
+  }
+  ASSERT(handovers == 0, "handovers", handovers);
+
+  set_output(subscribed);
+  {
+    auto task = guarded(seen);
+    task.handle().resume();
+    task.handle().resume();
+  }
+  // one exit at the suspension, one enter at the resumption
+  ASSERT(handovers == 2, "handovers", handovers);
+}
+}  // namespace rsl::logging::_test_context
@@ -0,0 +1,129 @@
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <rsl/log>
+#include <rsl/logging/crash.hpp>
+#include <rsl/logging/sinks.hpp>
+#include <rsl/test>
+
+namespace rsl::logging::_test_crash {
+constexpr int event_count = 20;
+
+// Runs `crash` in a forked child which logs `event_count` events into a FileSink that by default
+// would not write them out on its own for an hour. Returns the termination signal and the file
+// contents.
+template <typename F>
+std::pair<int, std::string> crash_child(std::string_view name,
+                                        F crash,
+                                        FileSink::Options options = {.max_age =
+                                                                         std::chrono::hours(1)}) {
+  auto const path = std::filesystem::temp_directory_path() / std::string(name);
+  std::filesystem::remove(path);
+
+  auto const pid = ::fork();
+  if (pid == 0) {
+    install_crash_handler(-1);
+    options.path       = path;
+    static auto output = Output(FileSink(options));
+    set_output(output);
+
+    Context request{"request", LogLevel::INHERIT};
+    request.enter();
+    for (int idx = 0; idx < event_count; ++idx) {
+      rsl::info("event {}", idx);
+    }
+    crash();
+    ::_exit(0);
+  }
+
+  int status = 0;
+  ::waitpid(pid, &status, 0);
+  auto contents = std::stringstream();
+  contents << std::ifstream(path).rdbuf();
+  std::filesystem::remove(path);
+  return {WIFSIGNALED(status) ? WTERMSIG(status) : 0, contents.str()};
+}
+
+[[=test]]
+void pending_events_survive_a_segfault() {
+  auto const [signal, contents] =
+      crash_child("rsl-log-crash-segv.log", [] { std::raise(SIGSEGV); });
+  ASSERT(signal == SIGSEGV, "signal was not re-raised", signal);
+  for (int idx = 0; idx < event_count; ++idx) {
+    ASSERT(contents.contains("event " + std::to_string(idx)), "lost event", idx);
+  }
+  ASSERT(contents.contains("FATAL crashed with SIGSEGV in request"), contents);
+}
+
+[[=test]]
+void pending_events_survive_terminate() {
+  auto const [signal, contents] =
+      crash_child("rsl-log-crash-terminate.log", [] { std::terminate(); });
+  ASSERT(signal == SIGABRT, signal);
+  ASSERT(contents.contains("event " + std::to_string(event_count - 1)));
+  ASSERT(contents.contains("FATAL crashed with std::terminate in request"), contents);
+}
+
+// every line wakes the writer, the crash lands while it still writes a batch
+[[=test]]
+void crash_waits_for_the_batch_in_flight() {
+  constexpr int bulk_count = 2000;
+  auto const [signal, contents] = crash_child(
+      "rsl-log-crash-in-flight.log",
+      [] {
+        auto const padding = std::string(1024, 'x');
+        for (int idx = 0; idx < bulk_count; ++idx) {
+          rsl::info("bulk {} {}", idx, padding);
+        }
+        std::raise(SIGSEGV);
+      },
+      {.buffer_size = 1, .max_age = std::chrono::hours(1)});
+  ASSERT(signal == SIGSEGV, signal);
+  for (int idx = 0; idx < bulk_count; ++idx) {
+    ASSERT(contents.contains("bulk " + std::to_string(idx) + " "), "lost event", idx);
+  }
+  ASSERT(contents.contains("FATAL crashed with SIGSEGV in request"));
+}
+
+// the second crash lands while a slow hook still runs, it must not cut the report short
+[[=test]]
+void later_crash_waits_for_the_report() {
+  static auto const path =
+      (std::filesystem::temp_directory_path() / "rsl-log-crash-concurrent.log").string();
+  static std::atomic<bool> reporting{false};
+  auto const [signal, contents] = crash_child("rsl-log-crash-concurrent.log", [] {
+    register_crash_hook(
+        [](void*, std::string_view) {
+          reporting.store(true);
+          constexpr timespec pause{0, 300'000'000};
+          ::nanosleep(&pause, nullptr);
+          auto const fd = ::open(path.c_str(), O_WRONLY | O_APPEND);
+          _impl::write_all(fd, "slow hook done\n");
+          ::close(fd);
+        },
+        nullptr);
+    std::thread([] {
+      while (not reporting.load()) {
+      }
+      std::raise(SIGSEGV);
+    }).detach();
+    std::raise(SIGSEGV);
+  });
+  ASSERT(signal == SIGSEGV, signal);
+  ASSERT(contents.contains("FATAL crashed with SIGSEGV in request"), contents);
+  ASSERT(contents.contains("slow hook done"), "second crash killed the report", contents);
+}
+}  // namespace rsl::logging::_test_crash
@@ -0,0 +1,137 @@
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <rsl/log>
+#include <rsl/logging/sinks.hpp>
+#include <rsl/test>
+
+namespace rsl::logging::_test_file {
+std::filesystem::path temp_file(std::string_view name) {
+  return std::filesystem::temp_directory_path() / std::string(name);
+}
+
+std::filesystem::path rotated(std::filesystem::path path, int idx) {
+  path += "." + std::to_string(idx);
+  return path;
+}
+
+std::string read(std::filesystem::path const& path) {
+  auto contents = std::stringstream();
+  contents << std::ifstream(path).rdbuf();
+  return contents.str();
+}
+
+// Installs an output writing to a fresh `name` in the temp directory. It stays installed until
+// the next test replaces it, the returned copy shares the sink's state.
+FileSink install(std::string_view name, FileSink::Options options) {
+  options.path = temp_file(name);
+  std::filesystem::remove(options.path);
+  for (int idx = 1; idx <= 5; ++idx) {
+    std::filesystem::remove(rotated(options.path, idx));
+  }
+
+  static std::deque<Output<FileSink>> outputs;
+  auto sink = FileSink(options);
+  set_output(outputs.emplace_back(FileSink(sink)));
+  return sink;
+}
+
+[[=test]]
+void flush_writes_pending_lines() {
+  auto sink = install("rsl-log-file-flush.log", {.max_age = std::chrono::hours(1)});
+  for (int idx = 0; idx < 10; ++idx) {
+    rsl::info("pending {}", idx);
+  }
+  ASSERT(sink.stats().writes == 0, "written before the buffer was due");
+
+  sink.flush();
+  auto const contents = read(temp_file("rsl-log-file-flush.log"));
+  for (int idx = 0; idx < 10; ++idx) {
+    ASSERT(contents.contains("pending " + std::to_string(idx) + "\n"), "lost line", idx);
+  }
+  ASSERT(sink.stats().writes >= 1);
+}
+
+[[=test]]
+void rotates_by_size() {
+  constexpr std::size_t max_size = 256;
+
+  auto sink = install("rsl-log-file-size.log",
+                      {.max_age       = std::chrono::hours(1),
+                       .max_file_size = max_size,
+                       .max_files     = 2});
+  for (int idx = 0; idx < 40; ++idx) {
+    rsl::info("sized {}", idx);
+    sink.flush();
+  }
+
+  auto const path = temp_file("rsl-log-file-size.log");
+  ASSERT(sink.stats().rotations >= 2, "rotations", sink.stats().rotations);
+  ASSERT(std::filesystem::exists(rotated(path, 1)));
+  ASSERT(std::filesystem::exists(rotated(path, 2)));
+  ASSERT(not std::filesystem::exists(rotated(path, 3)), "kept more than max_files");
+  for (auto const& file : {path, rotated(path, 1), rotated(path, 2)}) {
+    ASSERT(std::filesystem::file_size(file) <= max_size, file.string());
+  }
+  ASSERT(read(path).contains("sized 39\n"), "newest line not in the current file");
+}
+
+[[=test]]
+void rotates_by_age() {
+  auto sink = install("rsl-log-file-age.log",
+                      {.max_age           = std::chrono::hours(1),
+                       .rotation_interval = std::chrono::seconds(1)});
+  rsl::info("before rotation");
+  sink.flush();
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  rsl::info("after rotation");
+  sink.flush();
+
+  auto const path = temp_file("rsl-log-file-age.log");
+  ASSERT(sink.stats().rotations == 1, "rotations", sink.stats().rotations);
+  ASSERT(read(rotated(path, 1)).contains("before rotation"));
+  auto const current = read(path);
+  ASSERT(current.contains("after rotation"));
+  ASSERT(not current.contains("before rotation"));
+}
+
+[[=test]]
+void no_durability_never_syncs() {
+  auto sink = install("rsl-log-file-none.log", {});
+  rsl::info("unsynced");
+  sink.flush();
+  ASSERT(sink.stats().syncs == 0, "syncs", sink.stats().syncs);
+}
+
+[[=test]]
+void periodic_durability_syncs_batches() {
+  auto sink = install("rsl-log-file-periodic.log",
+                      {.durability    = FileSink::Durability::PERIODIC,
+                       .sync_interval = std::chrono::milliseconds(0)});
+  rsl::info("synced");
+  sink.flush();
+  ASSERT(sink.stats().syncs >= 1, "syncs", sink.stats().syncs);
+}
+
+// the event is on disk once the call returns, without a flush
+[[=test]]
+void fatal_waits_for_disk() {
+  auto sink = install("rsl-log-file-fatal.log",
+                      {.max_age    = std::chrono::hours(1),
+                       .durability = FileSink::Durability::ON_FATAL});
+  rsl::info("ahead of fatal");
+  rsl::fatal_error("fatal event");
+  ASSERT(sink.stats().syncs >= 1, "syncs", sink.stats().syncs);
+
+  auto const contents = read(temp_file("rsl-log-file-fatal.log"));
+  ASSERT(contents.contains("ahead of fatal\n"));
+  ASSERT(contents.contains("fatal event\n"));
+}
+}  // namespace rsl::logging::_test_file
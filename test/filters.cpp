@@ -0,0 +1,235 @@
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <rsl/log>
+#include <rsl/logging/filters.hpp>
+#include <rsl/test>
+
+namespace rsl::logging::_test_filters {
+using namespace std::chrono_literals;
+
+Metadata at(std::chrono::nanoseconds offset, Callsite const* callsite = nullptr) {
+  // a fixed origin keeps the tests independent of the clock
+  auto const origin = std::chrono::system_clock::time_point(std::chrono::hours(24 * 365 * 50));
+  auto const time   = origin + std::chrono::duration_cast<std::chrono::system_clock::duration>(offset);
+  return {.severity = LogLevel::WARNING, .timestamp = Timestamp(time), .callsite = callsite};
+}
+
+[[=test]]
+void rate_limit_admits_burst_then_rate() {
+  auto limit = rate_limit(10, 1s);
+  int admitted = 0;
+  for (int idx = 0; idx < 100; ++idx) {
+    admitted += limit.check(at(0ms)) ? 1 : 0;
+  }
+  ASSERT(admitted == 10, "burst defaults to the rate", admitted);
+  ASSERT(limit.suppressed() == 90);
+
+  // one token every 100ms, measured on the steady clock
+  ASSERT(not limit.check(at(0ms)));
+  std::this_thread::sleep_for(150ms);
+  ASSERT(limit.check(at(0ms)));
+  ASSERT(not limit.check(at(0ms)));
+}
+
+// the wall clock stepping back, ie. by NTP, neither suppresses the callsite nor refills it
+[[=test]]
+void rate_limit_ignores_event_timestamps() {
+  auto limit   = rate_limit(10, 1s);
+  int admitted = 0;
+  for (int idx = 0; idx < 20; ++idx) {
+    admitted += limit.check(at(std::chrono::hours(20 - idx))) ? 1 : 0;
+  }
+  ASSERT(admitted == 10, "admitted", admitted);
+
+  auto keyed = rate_limit_by([](Metadata const& meta) { return meta.context->name; }, 10, 1s);
+  admitted   = 0;
+  for (int idx = 0; idx < 20; ++idx) {
+    admitted += keyed.check(at(-std::chrono::hours(idx))) ? 1 : 0;
+  }
+  ASSERT(admitted == 10, "admitted", admitted);
+}
+
+[[=test]]
+void rate_limit_is_per_callsite() {
+  Callsite first{LogLevel::WARNING, "first", __FILE__, __LINE__, "", "", LogLevel::TRACE};
+  Callsite second{LogLevel::WARNING, "second", __FILE__, __LINE__, "", "", LogLevel::TRACE};
+  auto limit = rate_limit(1, 1s);
+  ASSERT(limit.check(at(0ms, &first)));
+  ASSERT(not limit.check(at(0ms, &first)));
+  ASSERT(limit.check(at(0ms, &second)), "callsites must not share a budget");
+}
+
+[[=test]]
+void copies_share_state() {
+  auto limit = rate_limit(1, 1s);
+  auto copy  = limit;
+  ASSERT(limit.check(at(0ms)));
+  ASSERT(not copy.check(at(0ms)));
+  ASSERT(limit.suppressed() == 1);
+}
+
+[[=test]]
+void keyed_rate_limit() {
+  auto limit = rate_limit_by([](Metadata const& meta) { return meta.context->name; }, 2, 1s);
+  Context a{"a", LogLevel::INHERIT};
+  Context b{"b", LogLevel::INHERIT};
+
+  auto meta_a = at(0ms);
+  auto meta_b = at(0ms);
+  meta_a.context = &a;
+  meta_b.context = &b;
+  ASSERT(limit.check(meta_a));
+  ASSERT(limit.check(meta_a));
+  ASSERT(not limit.check(meta_a));
+  ASSERT(limit.check(meta_b));
+  ASSERT(limit.suppressed() == 1);
+}
+
+[[=test]]
+void sample_lets_through_a_fraction() {
+  auto sampler = sample(10);
+  int admitted = 0;
+  for (int idx = 0; idx < 10'000; ++idx) {
+    admitted += sampler.check(at(0ms)) ? 1 : 0;
+  }
+  ASSERT(admitted > 700 && admitted < 1300, admitted);
+  ASSERT(sampler.suppressed() == std::uint64_t(10'000 - admitted));
+  ASSERT(sample(1).check(at(0ms)));
+}
+
+[[=test]]
+void contexts_are_never_dropped() {
+  auto limit = rate_limit(1, 1s);
+  ASSERT(limit.check(at(0ms)));
+  ASSERT(limit.process_context(at(0ms), true, false));
+  ASSERT(sample(1'000'000).process_context(at(0ms), false, false));
+}
+
+struct Collect : Sink {
+  std::vector<std::string>* lines;
+
+  explicit Collect(std::vector<std::string>& lines) : lines(&lines) {}
+  void emit_event(Event const& event) { lines->emplace_back(std::string(event.text())); }
+};
+
+Event message(std::chrono::nanoseconds offset, int attempt) {
+  return Event(at(offset), ::rsl::format("retry {}", attempt));
+}
+
+[[=test]]
+void dedup_collapses_runs() {
+  std::vector<std::string> lines;
+  auto pipeline = dedup(1s) >> Collect(lines);
+
+  for (int idx = 0; idx < 5; ++idx) {
+    pipeline.process_event(message(0ms, 1));
+  }
+  ASSERT(lines.size() == 1, "repeats are dropped", lines.size());
+
+  // a different message ends the run
+  pipeline.process_event(message(10ms, 2));
+  ASSERT(lines.size() == 3);
+  ASSERT(lines[0] == "retry 1");
+  ASSERT(lines[1] == "last message repeated 4 times", lines[1]);
+  ASSERT(lines[2] == "retry 2");
+}
+
+[[=test]]
+void dedup_window_expires() {
+  std::vector<std::string> lines;
+  auto pipeline = dedup(100ms) >> Collect(lines);
+
+  pipeline.process_event(message(0ms, 1));
+  pipeline.process_event(message(0ms, 1));
+  std::this_thread::sleep_for(150ms);
+  pipeline.process_event(message(0ms, 1));
+  ASSERT(lines.size() == 3, lines.size());
+  ASSERT(lines[1] == "last message repeated 1 time", lines[1]);
+  ASSERT(lines[2] == "retry 1");
+}
+
+// the window is measured on the steady clock, steps of the wall clock do not end a run
+[[=test]]
+void dedup_ignores_event_timestamps() {
+  std::vector<std::string> lines;
+  auto pipeline = dedup(1s) >> Collect(lines);
+  for (int idx = 0; idx < 5; ++idx) {
+    pipeline.process_event(message(std::chrono::hours(idx), 1));
+  }
+  ASSERT(lines.size() == 1, lines.size());
+}
+
+// runs of threads that stopped logging are summarized once their window passed
+[[=test]]
+void dedup_flush_summarizes_expired_runs() {
+  std::vector<std::string> lines;
+  auto output = Output(dedup(100ms) >> Collect(lines));
+  std::thread([&] {
+    for (int idx = 0; idx < 3; ++idx) {
+      output.emit(message(0ms, 1));
+    }
+  }).join();
+
+  output.flush();
+  ASSERT(lines.size() == 1, "flushed a run within its window");
+
+  std::this_thread::sleep_for(150ms);
+  output.flush();
+  ASSERT(lines.size() == 2, lines.size());
+  ASSERT(lines[1] == "last message repeated 2 times", lines[1]);
+
+  output.flush();
+  ASSERT(lines.size() == 2, "summarized twice");
+}
+
+[[=test]]
+void dedup_runs_are_per_thread() {
+  std::vector<std::string> lines;
+  auto pipeline = dedup(1s) >> Collect(lines);
+  pipeline.process_event(message(0ms, 1));
+  std::thread([&] { pipeline.process_event(message(0ms, 1)); }).join();
+  ASSERT(lines.size() == 2, "threads must not share a run");
+}
+
+[[=test]]
+void text_is_rendered_lazily_and_once() {
+  int renders = 0;
+  auto render = [&] {
+    ++renders;
+    return ::rsl::format("expensive {}", 42);
+  };
+
+  std::vector<std::string> lines;
+  auto rejected = filter([](Metadata const& meta) { return meta.severity >= LogLevel::ERROR; })
+                  >> Collect(lines);
+  rejected.process_event(Event::deferred(at(0ms), render));
+  ASSERT(renders == 0, "rejected events must not be formatted");
+
+  auto output = Output(Collect(lines), Collect(lines));
+  output.emit(Event::deferred(at(0ms), render));
+  ASSERT(renders == 1, renders);
+  ASSERT(lines.size() == 2);
+  ASSERT(lines[0] == "expensive 42");
+}
+
+[[=test]]
+void output_level_bound() {
+  static_assert(at_least(LogLevel::ERROR).min_level() == LogLevel::ERROR);
+  static_assert(Filter().min_level() == LogLevel::INHERIT);
+
+  std::vector<std::string> lines;
+  auto errors   = at_least(LogLevel::ERROR) >> Collect(lines);
+  auto warnings = at_least(LogLevel::INFO) >> at_least(LogLevel::WARNING) >> Collect(lines);
+  ASSERT(errors.min_level() == LogLevel::ERROR);
+  ASSERT(warnings.min_level() == LogLevel::WARNING, "All takes the strictest stage");
+  ASSERT(Output(auto(errors), auto(warnings)).min_level() == LogLevel::WARNING, "Any takes the most lenient");
+
+  // predicates cannot be bounded
+  auto predicate = filter([](Metadata const& meta) { return meta.severity >= LogLevel::ERROR; });
+  ASSERT(Output(predicate >> Collect(lines)).min_level() == LogLevel::INHERIT);
+  ASSERT(Output(auto(errors), Collect(lines)).min_level() == LogLevel::INHERIT);
+}
+}  // namespace rsl::logging::_test_filters
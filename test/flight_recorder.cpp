@@ -0,0 +1,139 @@
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <rsl/log>
+#include <rsl/logging/sinks.hpp>
+#include <rsl/test>
+
+namespace rsl::logging::_test_flight_recorder {
+struct Collect : Sink {
+  std::vector<std::string>* lines;
+
+  explicit Collect(std::vector<std::string>& lines) : lines(&lines) {}
+  void emit_event(Event const& event) { lines->emplace_back(std::string(event.text())); }
+};
+
+Event message(int idx, LogLevel severity = LogLevel::DEBUG) {
+  auto meta = Metadata{.severity  = severity,
+                       .timestamp = Timestamp::now(),
+                       .thread_id = std::this_thread::get_id()};
+  return Event(meta, ::rsl::format("event {}", idx));
+}
+
+std::vector<std::string> dump(FlightRecorderSink const& recorder) {
+  std::vector<std::string> lines;
+  auto output = Output(Collect(lines));
+  recorder.dump(output);
+  return lines;
+}
+
+[[=test]]
+void keeps_the_most_recent_events() {
+  auto recorder = FlightRecorderSink({.records_per_thread = 4, .max_threads = 2});
+  for (int idx = 0; idx < 10; ++idx) {
+    recorder.emit_event(message(idx));
+  }
+
+  auto const lines = dump(recorder);
+  ASSERT(lines.size() == 4, lines.size());
+  ASSERT(lines.front() == "event 6", lines.front());
+  ASSERT(lines.back() == "event 9", lines.back());
+}
+
+[[=test]]
+void merges_threads_and_truncates() {
+  auto recorder = FlightRecorderSink({.records_per_thread = 8, .max_threads = 2});
+  recorder.emit_event(message(0));
+  std::thread([&] { recorder.emit_event(message(1)); }).join();
+  recorder.emit_event(message(2));
+
+  // events of exited threads are kept
+  auto const lines = dump(recorder);
+  ASSERT(lines.size() == 3);
+  ASSERT(lines[0] == "event 0" && lines[1] == "event 1" && lines[2] == "event 2");
+
+  recorder.clear();
+  ASSERT(dump(recorder).empty());
+
+  auto meta = Metadata{.severity = LogLevel::INFO, .timestamp = Timestamp::now()};
+  recorder.emit_event(Event(meta, ::rsl::format("{}", std::string(1000, 'x'))));
+  auto const truncated = dump(recorder);
+  ASSERT(truncated.size() == 1);
+  ASSERT(truncated[0].size() < FlightRecorderSink::record_size);
+}
+
+[[=test]]
+void dumps_on_fatal() {
+  auto const path = std::filesystem::temp_directory_path() / "rsl-log-flight-recorder.log";
+  std::filesystem::remove(path);
+
+  auto recorder = FlightRecorderSink({.records_per_thread = 8, .max_threads = 1, .path = path});
+  recorder.emit_event(message(0));
+  ASSERT(not std::filesystem::exists(path));
+  recorder.emit_event(message(1, LogLevel::FATAL));
+  ASSERT(std::filesystem::file_size(path) > 0);
+  std::filesystem::remove(path);
+}
+
+// threads that recorded do not keep a destroyed recorder, or its signal, alive
+[[=test]]
+void recorder_is_released_by_recording_threads() {
+  auto const options = FlightRecorderSink::Options{
+      .records_per_thread = 8, .max_threads = 2, .dump_on_fatal = false, .signal = SIGUSR2};
+  {
+    auto recorder = FlightRecorderSink(options);
+    recorder.emit_event(message(0));
+  }
+
+  auto recorder = FlightRecorderSink(options);
+  recorder.emit_event(message(1));
+  auto const lines = dump(recorder);
+  ASSERT(lines.size() == 1);
+  ASSERT(lines[0] == "event 1", lines[0]);
+}
+
+// the handler only wakes the watcher thread, which appends the dump to `path`
+[[=test]]
+void dumps_on_signal() {
+  auto const path = std::filesystem::temp_directory_path() / "rsl-log-flight-signal.log";
+  std::filesystem::remove(path);
+
+  auto recorder = FlightRecorderSink({.records_per_thread = 8,
+                                      .max_threads        = 1,
+                                      .path               = path,
+                                      .dump_on_fatal      = false,
+                                      .signal             = SIGUSR2});
+  recorder.emit_event(message(0));
+  std::raise(SIGUSR2);
+
+  std::string contents;
+  auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (not contents.contains("event 0") && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    auto stream = std::stringstream();
+    stream << std::ifstream(path).rdbuf();
+    contents = stream.str();
+  }
+  ASSERT(contents.contains("event 0"), contents);
+  std::filesystem::remove(path);
+}
+
+// an output replaying the dump may contain the recorder itself
+[[=test]]
+void replaying_into_itself() {
+  auto output    = Output(FlightRecorderSink({.records_per_thread = 8, .max_threads = 1}));
+  auto& recorder = get<0>(output.elts);
+  recorder.emit_event(message(0));
+  recorder.emit_event(message(1, LogLevel::FATAL));
+  recorder.dump(output);
+
+  auto const lines = dump(recorder);
+  ASSERT(lines.size() == 2, "replayed events were recorded again", lines.size());
+}
+}  // namespace rsl::logging::_test_flight_recorder
@@ -1,6 +1,6 @@
 #include <rsl/logging/hierarchy.hpp>
 #include <rsl/test>
-#include "rsl/logging/logger.hpp"
+#include <rsl/log>
 
 namespace rsl::logging::_test_namespace {
   static void assert_min_level(const Namespace& root, std::string_view path, LogLevel expected) {
@@ -97,16 +97,48 @@ void remove_all_and_empty_string() {
   assert_no_override(root, "unknown::path");
 }
 
-// [[=rsl::test]]
-// void full_name_reconstruction() {
-//   Namespace root;
-//   auto* ns_foo = root.add_overrides("foo", Overrides{1});
-//   auto* ns_bar = root.add_overrides("foo::bar", Overrides{2});
-//   auto* ns_baz = root.add_overrides("foo::bar::baz", Overrides{3});
-
-//   ASSERT(ns_foo->full_name() == "foo", "Full name of 'foo'");
-//   ASSERT(ns_bar->full_name() == "foo::bar", "Full name of 'foo::bar'");
-//   ASSERT(ns_baz->full_name() == "foo::bar::baz", "Full name of 'foo::bar::baz'");
-//   ASSERT(root.full_name().empty(), "Root full name empty");
-// }
-}
\ No newline at end of file
+[[=test]]
+void full_name_reconstruction() {
+  Namespace root;
+  auto* ns_foo = root.add_overrides("foo", {.min_level=LogLevel::DEBUG});
+  auto* ns_bar = root.add_overrides("foo::bar", {.min_level=LogLevel::INFO});
+  auto* ns_baz = root.add_overrides("foo::bar::baz", {.min_level=LogLevel::ERROR});
+
+  ASSERT(ns_foo->full_name() == "foo", "Full name of 'foo'");
+  ASSERT(ns_bar->full_name() == "foo::bar", "Full name of 'foo::bar'");
+  ASSERT(ns_baz->full_name() == "foo::bar::baz", "Full name of 'foo::bar::baz'");
+  ASSERT(root.full_name().empty(), "Root full name empty");
+}
+
+struct CountingSink : Sink {
+  int* count;
+  void emit_event(Event const&) { ++*count; }
+};
+
+void log_info() {
+  rsl::info("hierarchy test");
+}
+
+[[=test]]
+void global_overrides_invalidate_callsites() {
+  static int count   = 0;
+  static auto output = Output(CountingSink{{}, &count});
+  set_output(output);
+  count = 0;
+
+  log_info();
+  ASSERT(count == 1, "callsite enabled by default");
+
+  add_overrides("rsl::logging::_test_namespace", {.min_level = LogLevel::WARNING});
+  log_info();
+  ASSERT(count == 1, "override raised the level");
+
+  add_overrides("rsl::logging::_test_namespace::log_info", {.min_level = LogLevel::DEBUG});
+  log_info();
+  ASSERT(count == 2, "closer override lowered it again");
+
+  remove_overrides("rsl::**");
+  log_info();
+  ASSERT(count == 3, "overrides removed");
+}
+}
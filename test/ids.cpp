@@ -0,0 +1,110 @@
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <rsl/log>
+#include <rsl/logging/sinks.hpp>
+#include <rsl/test>
+
+namespace rsl::logging::_test_ids {
+constexpr std::string_view example = "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01";
+
+[[=test]]
+void ids_are_nonzero_and_distinct() {
+  std::set<std::uint64_t> seen;
+  for (int idx = 0; idx < 1000; ++idx) {
+    auto const id = Context::next_id();
+    ASSERT(id != 0);
+    ASSERT(seen.insert(id).second, "duplicate id", id);
+  }
+  ASSERT(TraceId::generate().is_valid());
+}
+
+[[=test]]
+void traceparent_round_trips() {
+  auto const parsed = TraceParent::parse(example);
+  ASSERT(parsed.has_value());
+  ASSERT(parsed->trace_id.high == 0x4bf9'2f35'77b3'4da6ULL);
+  ASSERT(parsed->trace_id.low == 0xa3ce'929d'0e0e'4736ULL);
+  ASSERT(parsed->parent_id == 0x00f0'67aa'0ba9'02b7ULL);
+  ASSERT(parsed->flags == TraceParent::sampled);
+  ASSERT(parsed->to_string() == example);
+}
+
+[[=test]]
+void malformed_traceparent_is_rejected() {
+  ASSERT(not TraceParent::parse("").has_value());
+  ASSERT(not TraceParent::parse("00-00000000000000000000000000000000-00f067aa0ba902b7-01"));
+  ASSERT(not TraceParent::parse("00-4bf92f3577b34da6a3ce929d0e0e4736-0000000000000000-01"));
+  ASSERT(not TraceParent::parse("00-4BF92F3577B34DA6A3CE929D0E0E4736-00f067aa0ba902b7-01"));
+  ASSERT(not TraceParent::parse("ff-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01"));
+  ASSERT(not TraceParent::parse("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01-"));
+  // future versions may append fields
+  ASSERT(TraceParent::parse("01-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01-xyz"));
+}
+
+[[=test]]
+void nested_contexts_share_the_trace() {
+  Context outer{"outer", LogLevel::INHERIT};
+  Context inner{"inner", LogLevel::INHERIT};
+  outer.enter();
+  inner.enter();
+  ASSERT(outer.trace_id.is_valid());
+  ASSERT(inner.trace_id == outer.trace_id);
+  ASSERT(inner.id != outer.id);
+  inner.exit();
+  outer.exit();
+
+  Context other{"other", LogLevel::INHERIT};
+  other.enter();
+  ASSERT(other.trace_id != outer.trace_id, "root contexts must start a new trace");
+  other.exit();
+}
+
+[[=test]]
+void extracted_trace_is_continued() {
+  Context incoming{"incoming", LogLevel::INHERIT};
+  ASSERT(extract_traceparent(example, incoming));
+  incoming.enter();
+  ASSERT(incoming.trace_id == TraceParent::parse(example)->trace_id);
+  ASSERT(incoming.remote_parent == 0x00f0'67aa'0ba9'02b7ULL);
+
+  auto const outgoing = TraceParent::parse(inject_traceparent(incoming));
+  ASSERT(outgoing.has_value());
+  ASSERT(outgoing->trace_id == incoming.trace_id);
+  ASSERT(outgoing->parent_id == incoming.id);
+  incoming.exit();
+
+  Context untouched{"untouched", LogLevel::INHERIT};
+  ASSERT(not extract_traceparent("garbage", untouched));
+  ASSERT(not untouched.trace_id.is_valid());
+}
+
+// random span IDs do not fit a double, the JSON output carries them as hex strings
+[[=test]]
+void json_lines_show_span_ids_as_hex() {
+  auto const path = std::filesystem::temp_directory_path() / "rsl-log-ids-test.jsonl";
+  static auto sink   = JsonLinesSink(path);
+  static auto output = Output(JsonLinesSink(sink));
+  set_output(output);
+
+  Context incoming{"incoming", LogLevel::INHERIT};
+  ASSERT(extract_traceparent(example, incoming));
+  incoming.enter();
+  auto const id = std::format("{:016x}", incoming.id);
+  incoming.exit();
+  sink.flush();
+
+  auto contents = std::stringstream();
+  contents << std::ifstream(path).rdbuf();
+  auto const written = contents.str();
+  std::filesystem::remove(path);
+  ASSERT(written.contains("\"id\":\"" + id + "\",\"parent_span_id\":\"00f067aa0ba902b7\""),
+         written);
+  ASSERT(written.contains("\"context\":{\"id\":\"" + id + "\",\"name\":\"incoming\"}"), written);
+}
+}  // namespace rsl::logging::_test_ids
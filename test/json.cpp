@@ -0,0 +1,54 @@
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <rsl/log>
+#include <rsl/test>
+
+namespace {
+enum class Color { RED, GREEN };
+
+struct Point {
+  int x;
+  int y;
+};
+
+struct Shape {
+  std::string name;
+  Color color;
+  std::vector<Point> points;
+  std::optional<int> layer;
+};
+
+template <typename T>
+std::string to_json(T value) {
+  return rsl::logging::Field("value", &value).to_json();
+}
+
+[[=rsl::test]]
+void test_json_scalars() {
+  ASSERT(to_json(true) == "true");
+  ASSERT(to_json(42) == "42");
+  ASSERT(to_json(std::string("a\"b\n")) == R"("a\"b\n")");
+  ASSERT(to_json(Color::GREEN) == R"("GREEN")");
+  ASSERT(to_json(std::optional<int>()) == "null");
+}
+
+[[=rsl::test]]
+void test_json_aggregates() {
+  auto shape = Shape{.name = "line", .color = Color::RED, .points = {{0, 1}, {2, 3}}};
+  ASSERT(to_json(shape) ==
+         R"({"name":"line","color":"RED","points":[{"x":0,"y":1},{"x":2,"y":3}],"layer":null})");
+  ASSERT(to_json(std::map<std::string, int>{{"a", 1}, {"b", 2}}) == R"({"a":1,"b":2})");
+}
+
+[[=rsl::test]]
+void test_json_appends() {
+  int value = 1;
+  auto field = rsl::logging::Field("value", &value);
+  std::string out = "[";
+  field.to_json(out);
+  ASSERT(out == "[1");
+}
+}  // namespace
@@ -0,0 +1,181 @@
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <rsl/log>
+#include <rsl/logging/filters.hpp>
+#include <rsl/logging/metrics.hpp>
+#include <rsl/test>
+
+namespace rsl::logging::_test_metrics {
+// sinks are found in the snapshot by type name, every test uses its own
+struct Counted : Sink {
+  void emit_event(Event const& event) { report_bytes(event.text().size()); }
+};
+
+struct Lossy : Sink {
+  void emit_event(Event const&) { report_dropped(); }
+};
+
+struct Scoped : Sink {
+  void emit_event(Event const&) {}
+};
+
+struct Threaded : Sink {
+  void emit_event(Event const&) {}
+};
+
+struct Exported : Sink {
+  void emit_event(Event const&) {}
+};
+
+struct Sampled : Sink {
+  void emit_event(Event const&) {}
+};
+
+struct Summarized : Sink {
+  void emit_event(Event const&) {}
+};
+
+Event event(LogLevel severity) {
+  return Event(Metadata{.severity = severity}, ::rsl::format("payload"));
+}
+
+std::optional<SinkMetrics> find(std::string_view name) {
+  for (auto& sink : metrics_snapshot()) {
+    if (sink.name == name) {
+      return sink;
+    }
+  }
+  return std::nullopt;
+}
+
+[[=test]]
+void counts_per_sink_and_level() {
+  set_latency_sampling(1);
+  auto output = Output(at_least(LogLevel::WARNING) >> Counted(), Lossy());
+  for (int idx = 0; idx < 3; ++idx) {
+    output.emit(event(LogLevel::INFO));
+  }
+  output.emit(event(LogLevel::WARNING));
+  output.emit(event(LogLevel::ERROR));
+
+  auto counted = find("Counted");
+  ASSERT(counted.has_value());
+  ASSERT(counted->at(LogLevel::INFO).filtered == 3, counted->at(LogLevel::INFO).filtered);
+  ASSERT(counted->at(LogLevel::INFO).accepted == 0);
+  ASSERT(counted->at(LogLevel::WARNING).accepted == 1);
+  ASSERT(counted->at(LogLevel::WARNING).bytes == std::string_view("payload").size());
+  ASSERT(counted->total().accepted == 2);
+  ASSERT(counted->latency.count() == 2, "only accepted events are timed");
+
+  auto lossy = find("Lossy");
+  ASSERT(lossy.has_value());
+  ASSERT(lossy->at(LogLevel::INFO).accepted == 3);
+  ASSERT(lossy->at(LogLevel::INFO).dropped == 3);
+  ASSERT(lossy->total().filtered == 0);
+}
+
+[[=test]]
+void destroyed_outputs_are_unregistered() {
+  {
+    auto output = Output(Scoped());
+    output.emit(event(LogLevel::INFO));
+    ASSERT(find("Scoped").has_value());
+  }
+  ASSERT(not find("Scoped").has_value());
+}
+
+[[=test]]
+void counts_of_exited_threads_are_kept() {
+  auto output = Output(Threaded());
+  std::thread([&] { output.emit(event(LogLevel::ERROR)); }).join();
+  output.emit(event(LogLevel::ERROR));
+
+  auto threaded = find("Threaded");
+  ASSERT(threaded.has_value());
+  ASSERT(threaded->at(LogLevel::ERROR).accepted == 2, threaded->at(LogLevel::ERROR).accepted);
+}
+
+// the summary is counted as a sink call of its own, at the severity of the repeats
+[[=test]]
+void dedup_summary_is_counted_separately() {
+  set_latency_sampling(1);
+  auto output = Output(dedup(std::chrono::seconds(1)) >> Summarized());
+  for (int idx = 0; idx < 3; ++idx) {
+    output.emit(Event(Metadata{.severity = LogLevel::WARNING, .timestamp = Timestamp::now()},
+                      ::rsl::format("repeated")));
+  }
+  output.emit(Event(Metadata{.severity = LogLevel::ERROR, .timestamp = Timestamp::now()},
+                    ::rsl::format("different")));
+
+  auto summarized = find("Summarized");
+  ASSERT(summarized.has_value());
+  // the first event and the summary of its two repeats
+  auto const& warning = summarized->at(LogLevel::WARNING);
+  ASSERT(warning.accepted == 2, warning.accepted);
+  ASSERT(warning.filtered == 2, warning.filtered);
+  auto const& error = summarized->at(LogLevel::ERROR);
+  ASSERT(error.accepted == 1, error.accepted);
+  ASSERT(error.filtered == 0);
+  ASSERT(summarized->latency.count() == 3, "every sink call is timed");
+}
+
+// counters stay exact, only the timing is sampled
+[[=test]]
+void latency_is_sampled_per_thread() {
+  auto output = Output(Sampled());
+  set_latency_sampling(4);
+  for (int idx = 0; idx < 8; ++idx) {
+    output.emit(event(LogLevel::INFO));
+  }
+  set_latency_sampling(0);
+  for (int idx = 0; idx < 8; ++idx) {
+    output.emit(event(LogLevel::INFO));
+  }
+  set_latency_sampling(64);
+
+  auto sampled = find("Sampled");
+  ASSERT(sampled.has_value());
+  ASSERT(sampled->at(LogLevel::INFO).accepted == 16, sampled->at(LogLevel::INFO).accepted);
+  ASSERT(sampled->latency.count() == 2, sampled->latency.count());
+}
+
+[[=test]]
+void latency_buckets_are_log_linear() {
+  using H = LatencyHistogram;
+  ASSERT(H::bucket_for(0) == 0);
+  ASSERT(H::bucket_for(15) == 0);
+  ASSERT(H::bucket_for(16) == 1);
+  ASSERT(H::bucket_for(20) == 2);
+  ASSERT(H::bucket_for(1ULL << 40) == H::bucket_count - 1);
+  for (std::uint64_t ns : {17ULL, 100ULL, 1'000ULL, 123'456ULL, 5'000'000'000ULL}) {
+    auto const bucket = H::bucket_for(ns);
+    ASSERT(H::upper_bound(bucket) >= ns, ns);
+    ASSERT(H::upper_bound(bucket - 1) < ns, ns);
+    // 4 buckets per power of two, each at most 25% wide
+    ASSERT(H::upper_bound(bucket) - H::upper_bound(bucket - 1) <= ns / 4 + 1, ns);
+  }
+}
+
+[[=test]]
+void prometheus_exposition() {
+  set_latency_sampling(1);
+  auto output = Output(Exported());
+  output.emit(event(LogLevel::INFO));
+
+  auto exported = find("Exported");
+  ASSERT(exported.has_value());
+  auto const text   = to_prometheus({&*exported, 1});
+  auto const labels = std::string("sink=\"Exported\",id=\"") + std::to_string(exported->id) + "\"";
+
+  ASSERT(text.contains("# TYPE rsl_log_events_accepted_total counter\n"));
+  ASSERT(text.contains("rsl_log_events_accepted_total{" + labels + ",level=\"INFO\"} 1\n"), text);
+  ASSERT(text.contains("rsl_log_events_filtered_total{" + labels + ",level=\"INFO\"} 0\n"), text);
+  ASSERT(text.contains("# TYPE rsl_log_sink_emit_seconds histogram\n"));
+  ASSERT(text.contains("rsl_log_sink_emit_seconds_bucket{" + labels + ",le=\"+Inf\"} 1\n"), text);
+  ASSERT(text.contains("rsl_log_sink_emit_seconds_count{" + labels + "} 1\n"), text);
+}
+}  // namespace rsl::logging::_test_metrics
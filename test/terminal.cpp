@@ -0,0 +1,60 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <rsl/log>
+#include <rsl/logging/sinks.hpp>
+#include <rsl/test>
+
+namespace rsl::logging::_test_terminal {
+// everything `fn` writes to stdout, including lines the sink still buffered
+template <typename F>
+std::string capture_stdout(F fn) {
+  auto const path = std::filesystem::temp_directory_path() / "rsl-log-terminal-test.log";
+  TerminalSink::flush();
+  std::fflush(stdout);
+
+  auto const saved = ::dup(STDOUT_FILENO);
+  auto const file  = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  ::dup2(file, STDOUT_FILENO);
+  ::close(file);
+
+  fn();
+  TerminalSink::flush();
+
+  ::dup2(saved, STDOUT_FILENO);
+  ::close(saved);
+
+  auto contents = std::stringstream();
+  contents << std::ifstream(path).rdbuf();
+  std::filesystem::remove(path);
+  return contents.str();
+}
+
+// the WARNING writes out the buffer while the exit line is still to come
+[[=test]]
+void events_and_context_lines_keep_their_order() {
+  static auto output = Output(TerminalSink());
+  set_output(output);
+
+  auto const written = capture_stdout([] {
+    rsl::info("first");
+    Context scope{"scope", LogLevel::INHERIT};
+    scope.enter();
+    rsl::warn("second");
+    scope.exit();
+    rsl::info("third");
+  });
+
+  std::size_t offset = 0;
+  for (auto line : {") first", "entered scope\n", ") second", "exited scope\n", ") third"}) {
+    offset = written.find(line, offset);
+    ASSERT(offset != std::string::npos, "missing or out of order", line, written);
+  }
+}
+}  // namespace rsl::logging::_test_terminal
@@ -0,0 +1,295 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <print>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <rsl/logging/level.hpp>
+#include <rsl/logging/_impl/binary_format.hpp>
+
+// Turns files written by BinaryFileSink back into TerminalSink text or JSON lines.
+// Records are decoded one at a time, memory use only depends on the size of the dictionary.
+
+namespace binary = rsl::logging::_impl::binary;
+using rsl::logging::LogLevel;
+
+namespace {
+struct Callsite {
+  std::uint32_t file;
+  std::uint32_t function;
+  std::uint32_t line;
+};
+
+struct FieldValue {
+  std::uint32_t name;
+  std::uint32_t type;
+  std::string_view value;
+};
+
+struct Decoder {
+  bool json = false;
+  std::vector<std::string> strings;
+  std::vector<Callsite> callsites;
+  std::vector<FieldValue> arguments;
+  std::vector<FieldValue> extra;
+
+  std::string_view string(std::uint32_t id) const {
+    return id < strings.size() ? std::string_view(strings[id]) : std::string_view("<unknown>");
+  }
+
+  Callsite callsite(std::uint32_t id) const {
+    return id < callsites.size() ? callsites[id] : Callsite{};
+  }
+
+  static void read_fields(binary::Reader& reader, std::vector<FieldValue>& fields) {
+    fields.clear();
+    auto count = reader.get<std::uint16_t>();
+    for (std::uint16_t idx = 0; idx < count && reader.ok; ++idx) {
+      auto name  = reader.get<std::uint32_t>();
+      auto type  = reader.get<std::uint32_t>();
+      auto value = reader.get_string();
+      fields.push_back({name, type, value});
+    }
+  }
+
+  static std::chrono::system_clock::time_point to_time_point(std::int64_t unix_ns) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(unix_ns)));
+  }
+
+  static void print_json_string(std::string_view value) {
+    std::string escaped;
+    escaped.reserve(value.size() + 2);
+    escaped += '"';
+    for (char c : value) {
+      switch (c) {
+        case '"': escaped += "\\\""; break;
+        case '\\': escaped += "\\\\"; break;
+        case '\n': escaped += "\\n"; break;
+        case '\r': escaped += "\\r"; break;
+        case '\t': escaped += "\\t"; break;
+        default:
+          if (static_cast<unsigned char>(c) < 0x20) {
+            escaped += std::format("\\u{:04x}", static_cast<unsigned>(c));
+          } else {
+            escaped += c;
+          }
+      }
+    }
+    escaped += '"';
+    std::fwrite(escaped.data(), 1, escaped.size(), stdout);
+  }
+
+  void print_json_fields(std::string_view key, std::vector<FieldValue> const& fields) const {
+    std::print(",\"{}\":{{", key);
+    bool first = true;
+    for (auto const& field : fields) {
+      if (not first) {
+        std::print(",");
+      }
+      first = false;
+      print_json_string(string(field.name));
+      std::print(":");
+      print_json_string(field.value);
+    }
+    std::print("}}");
+  }
+
+  void print_json_location(Callsite const& location) const {
+    std::print(",\"file\":");
+    print_json_string(string(location.file));
+    std::print(",\"line\":{},\"function\":", location.line);
+    print_json_string(string(location.function));
+  }
+
+  void on_event(binary::Reader& reader) {
+    auto location   = callsite(reader.get<std::uint32_t>());
+    auto severity   = LogLevel(reader.get<std::uint8_t>());
+    auto timestamp  = reader.get<std::int64_t>();
+    auto thread     = reader.get<std::uint64_t>();
+    auto context_id = reader.get<std::uint64_t>();
+    auto name       = string(reader.get<std::uint32_t>());
+    auto text       = reader.get_string();
+    read_fields(reader, arguments);
+    read_fields(reader, extra);
+    if (not reader.ok) {
+      return;
+    }
+
+    if (not json) {
+      std::println("{} ({: >8} {}) {}", to_time_point(timestamp), name, context_id, text);
+      return;
+    }
+
+    std::print("{{\"type\":\"event\",\"timestamp\":{},\"severity\":\"{}\",\"thread\":{}",
+               timestamp,
+               rsl::logging::level_name(severity),
+               thread);
+    std::print(",\"context\":{{\"id\":\"{:016x}\",\"name\":", context_id);
+    print_json_string(name);
+    std::print("}}");
+    print_json_location(location);
+    std::print(",\"message\":");
+    print_json_string(text);
+    print_json_fields("arguments", arguments);
+    print_json_fields("extra", extra);
+    std::println("}}");
+  }
+
+  void on_context(binary::Reader& reader) {
+    auto entered    = reader.get<std::uint8_t>() != 0;
+    auto handover   = reader.get<std::uint8_t>() != 0;
+    auto timestamp  = reader.get<std::int64_t>();
+    auto thread     = reader.get<std::uint64_t>();
+    auto context_id = reader.get<std::uint64_t>();
+    auto name       = string(reader.get<std::uint32_t>());
+    auto location   = callsite(reader.get<std::uint32_t>());
+    read_fields(reader, arguments);
+    read_fields(reader, extra);
+    if (not reader.ok) {
+      return;
+    }
+
+    if (not json) {
+      if (not entered) {
+        std::println("exited {}", name);
+        return;
+      }
+      std::println("entered {}", name);
+      for (auto const& field : arguments) {
+        std::println("  {} = {}", string(field.name), field.value);
+      }
+      for (auto const& field : extra) {
+        std::println("  {} = {}", string(field.name), field.value);
+      }
+      return;
+    }
+
+    std::print("{{\"type\":\"{}\",\"handover\":{},\"timestamp\":{},\"thread\":{}",
+               entered ? "enter" : "exit",
+               handover,
+               timestamp,
+               thread);
+    std::print(",\"context\":{{\"id\":\"{:016x}\",\"name\":", context_id);
+    print_json_string(name);
+    std::print("}}");
+    print_json_location(location);
+    print_json_fields("arguments", arguments);
+    print_json_fields("extra", extra);
+    std::println("}}");
+  }
+
+  bool on_record(binary::RecordKind kind, binary::Reader& reader) {
+    switch (kind) {
+      using enum binary::RecordKind;
+      case STRING: {
+        auto id    = reader.get<std::uint32_t>();
+        auto value = reader.get_string();
+        if (id >= strings.size()) {
+          strings.resize(id + 1);
+        }
+        strings[id] = value;
+        break;
+      }
+      case CALLSITE: {
+        auto id       = reader.get<std::uint32_t>();
+        auto location = Callsite{reader.get<std::uint32_t>(),
+                                 reader.get<std::uint32_t>(),
+                                 reader.get<std::uint32_t>()};
+        if (id >= callsites.size()) {
+          callsites.resize(id + 1);
+        }
+        callsites[id] = location;
+        break;
+      }
+      case EVENT: on_event(reader); break;
+      case CONTEXT: on_context(reader); break;
+      default:
+        // unknown record kinds are skipped so newer writers stay readable
+        break;
+    }
+    return reader.ok;
+  }
+};
+
+int decode(std::FILE* file, bool json) {
+  char header[binary::header_size];
+  if (std::fread(header, 1, sizeof(header), file) != sizeof(header) ||
+      std::memcmp(header, binary::magic, sizeof(binary::magic)) != 0) {
+    std::println(stderr, "not an rsl-log binary file");
+    return 1;
+  }
+
+  auto reader     = binary::Reader{header, sizeof(binary::magic)};
+  auto version    = reader.get<std::uint32_t>();
+  auto byte_order = reader.get<std::uint32_t>();
+  if (byte_order != binary::byte_order) {
+    std::println(stderr, "file was written on a machine with different byte order");
+    return 1;
+  }
+  if (version > binary::version) {
+    std::println(stderr, "unsupported format version {}", version);
+    return 1;
+  }
+
+  auto decoder = Decoder{.json = json};
+  std::vector<char> payload;
+  char record_header[binary::record_header_size];
+  while (std::fread(record_header, 1, sizeof(record_header), file) == sizeof(record_header)) {
+    auto header_reader = binary::Reader{record_header};
+    auto size          = header_reader.get<std::uint32_t>();
+    auto kind          = binary::RecordKind(header_reader.get<std::uint8_t>());
+
+    payload.resize(size);
+    if (std::fread(payload.data(), 1, size, file) != size) {
+      std::println(stderr, "truncated record");
+      return 1;
+    }
+
+    auto record_reader = binary::Reader{payload};
+    if (not decoder.on_record(kind, record_reader)) {
+      std::println(stderr, "malformed record");
+      return 1;
+    }
+  }
+  return 0;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool json             = false;
+  char const* file_name = nullptr;
+  for (int idx = 1; idx < argc; ++idx) {
+    auto arg = std::string_view(argv[idx]);
+    if (arg == "--json") {
+      json = true;
+    } else if (arg == "--text") {
+      json = false;
+    } else if (file_name == nullptr) {
+      file_name = argv[idx];
+    } else {
+      file_name = nullptr;
+      break;
+    }
+  }
+
+  if (file_name == nullptr) {
+    std::println(stderr, "usage: {} [--text|--json] <file|->", argc > 0 ? argv[0] : "rsl-log-decode");
+    return 2;
+  }
+
+  std::FILE* file = std::string_view(file_name) == "-" ? stdin : std::fopen(file_name, "rb");
+  if (file == nullptr) {
+    std::println(stderr, "could not open {}", file_name);
+    return 1;
+  }
+
+  auto result = decode(file, json);
+  if (file != stdin) {
+    std::fclose(file);
+  }
+  return result;
+}